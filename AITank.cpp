@@ -3,13 +3,16 @@
 //
 
 #include "AITank.h"
-#include "Bullet.h"     // 如果 AITank 的特定逻辑直接创建子弹 (目前是调用基类 shoot)
-#include "Game.h"       // 包含 Game.h 以便使用 Game& game 引用
+#include "World.h"      // 包含 World.h 以便使用 World& world 引用
+#include "FlowField.h"  // 基地流场查询
+#include "DStarLite.h"  // 追击玩家的增量寻路
+#include "ReservationTable.h" // 时空预留 (协同让行)
 #include <iostream>     // 用于调试输出
 #include <vector>       // 用于 std::vector (例如在 decideNextAction 中)
 #include <cmath>        // 用于 std::abs 等数学函数
+#include <algorithm>    // 用于 std::max
 
-// MODIFIED: 构造函数实现，增加了 tankType 和 game 参数
+// MODIFIED: 构造函数实现，增加了 tankType 和 world 参数
 float AITank::getRandomValue(float base, float factor) {
     std::uniform_real_distribution<float> dist(-factor, factor);
     return base * (1.0f + dist(m_rng)); // m_rng 是 AITank.h 中已有的随机数引擎
@@ -22,18 +25,20 @@ int AITank::getRandomValueInt(int base, float factor) {
 
 
 // 修改后的构造函数
-AITank::AITank(sf::Vector2f startPosition, Direction direction, const std::string& tankType, Game& game,
-               float baseSpeed, int baseHealth, int baseAttack, int frameW, int frameH, int scoreValue) // ++ 接收 scoreValue ++
-        : Tank(startPosition, direction, tankType, game,
+AITank::AITank(sf::Vector2f startPosition, Direction direction, const std::string& tankType, World& world,
+               float baseSpeed, int baseHealth, int baseAttack, int frameW, int frameH, int scoreValue, // ++ 接收 scoreValue ++
+               unsigned int rngSeed)
+        : Tank(startPosition, direction, tankType, world,
                baseSpeed, // 直接使用传入的基础速度
                frameW,
                frameH,
                baseHealth, // 直接使用传入的基础生命值
                0,          // AI坦克默认护甲为0
-               scoreValue),// ++ 将 scoreValue 传递给 Tank 基类 ++
+               scoreValue, // ++ 将 scoreValue 传递给 Tank 基类 ++
+               TankKind::AI),
           m_isMovingToNextTile(false),
         // ... 其他 AITank 特有成员的初始化 ...
-          m_rng(std::random_device{}()), // 确保 m_rng 被初始化
+          m_rng(rngSeed), // 确保 m_rng 被初始化 (种子由 World 提供)
           m_cooldownDistribution(0.8f, 2.5f) // 这个也可以考虑从配置中读取或根据AI类型变化
 {
     // --- 属性随机化 ---
@@ -60,14 +65,17 @@ AITank::AITank(sf::Vector2f startPosition, Direction direction, const std::strin
     m_currentAttackPower = m_baseAttackPower;
 
 
-    std::cout << "AITank (type '" << getTankType() << "') created. "
+    LOG_DEBUG("AITank (type '" << getTankType() << "') created. "
               << "HP: " << m_health << "/" << m_MaxHealth
               << ", Speed: " << m_speed
               << ", Attack: " << m_currentAttackPower
-              << ", Score: " << getScoreValue() << std::endl;
+              << ", Score: " << getScoreValue());
 
     generateNewRandomCooldown();
 }
+
+AITank::~AITank() = default;
+
 // 生成一个新的随机射击冷却时间
 void AITank::generateNewRandomCooldown() {
     m_aiShootCooldown = sf::seconds(m_cooldownDistribution(m_rng)); // 从分布中抽取一个随机值作为冷却时间
@@ -85,9 +93,9 @@ void AITank::resetShootTimerAI() {
     generateNewRandomCooldown();     // 生成下一次射击的冷却时间
 }
 
-// MODIFIED: AI坦克的更新逻辑，现在接收 Game& game 参数
-void AITank::update(sf::Time dt, Game& game) {
-    Tank::update(dt, game); // 调用基类 Tank 的 update 方法，传递 game 引用 (用于动画和通用buff等)
+// MODIFIED: AI坦克的更新逻辑，现在接收 World& world 参数
+void AITank::update(sf::Time dt, World& world) {
+    Tank::update(dt, world); // 调用基类 Tank 的 update 方法，传递 world 引用 (用于动画和通用buff等)
 
     // 更新AI特有的射击计时器
     if(m_aiShootTimer < m_aiShootCooldown) {
@@ -110,19 +118,19 @@ void AITank::update(sf::Time dt, Game& game) {
 
             m_isSlowDebuffActive = false;        // 标记debuff为非激活
             m_slowDebuffDuration = sf::Time::Zero; // 重置debuff持续时间
-            std::cout << "AITank (type '" << getTankType() << "') at (" << get_position().x << "," << get_position().y
-                      << ") slow debuff expired. Stats restored." << std::endl;
+            LOG_DEBUG("AITank (type '" << getTankType() << "') at (" << get_position().x << "," << get_position().y
+                      << ") slow debuff expired. Stats restored.");
         }
     }
     // 注意: AI的移动决策 (decideNextAction) 和格子间移动 (updateMovementBetweenTiles)
-    // 通常在 Game::update 循环中被显式调用，而不是在这个 AITank::update 内部。
+    // 通常在 World::step 中被显式调用，而不是在这个 AITank::update 内部。
     // 这个 AITank::update 主要负责调用基类 update 和处理 AITank 特有的计时器/状态。
 }
 
 // 获取AI坦克当前所在的瓦片坐标
 sf::Vector2i AITank::getCurrentTile(const Map& map) const {
     if (map.getTileWidth() == 0 || map.getTileHeight() == 0) { // 防止除以零错误
-        std::cerr << "AITank::getCurrentTile Error: Map tile dimensions are zero." << std::endl;
+        LOG_ERROR("AITank::getCurrentTile Error: Map tile dimensions are zero.");
         return {-1, -1};
     }
     return {
@@ -140,12 +148,77 @@ sf::Vector2f AITank::getPixelCenterForTile(int tileX, int tileY, const Map& map)
 }
 
 // AI决策下一步行动 (例如，向哪个邻近格子移动)
-void AITank::decideNextAction(const Map& map, const Tank* playerTankRef) {
+void AITank::decideNextAction(const Map& map, const Tank* playerTankRef, const FlowField* baseFlowField,
+                              ReservationTable* reservations) {
     if (m_isMovingToNextTile || isDestroyed()) { // 如果正在移动或已被摧毁，则不进行新的移动决策
         return;
     }
+    const std::uint64_t ticksPerStep = reservations
+            ? reservations->ticksPerStep(getSpeed(), std::max(map.getTileWidth(), map.getTileHeight())) : 1;
+    if (reservations && isYielding(reservations->getCurrentTick())) { // 让行等待中，保持原有预留
+        return;
+    }
+
+    // 追击型AI：沿最近一次规划的路径走向玩家 (新的规划可能还在 World 的寻路请求队列中排队)；
+    // 玩家已被摧毁或没有可用路径时按进攻基地处理
+    bool pursuingPlayer = false;
+    if (m_behavior == AIBehavior::HuntPlayer && playerTankRef && !playerTankRef->isDestroyed() &&
+        map.getTileWidth() > 0 && map.getTileHeight() > 0) {
+        sf::Vector2i currentTile = getCurrentTile(map);
+        sf::Vector2i playerTile(static_cast<int>(playerTankRef->get_position().x / map.getTileWidth()),
+                                static_cast<int>(playerTankRef->get_position().y / map.getTileHeight()));
+        if (hasPursuitPath()) {
+            sf::Vector2i pursuitNextTile = m_pursuitPath[m_pursuitPathCursor];
+            sf::Vector2i step = pursuitNextTile - currentTile;
+            if (std::abs(step.x) + std::abs(step.y) == 1) {
+                pursuingPlayer = true;
+                Direction pursuitDirection = (step.x < 0) ? Direction::LEFT : (step.x > 0) ? Direction::RIGHT
+                                           : (step.y < 0) ? Direction::UP : Direction::DOWN;
+                m_intendedDirectionForTileMove = pursuitDirection;
+                if (pursuitNextTile == playerTile || !map.isTileWalkable(pursuitNextTile.x, pursuitNextTile.y)) {
+                    // 已贴近玩家，或前方是砖墙：原地转向，由自动射击攻击
+                    turnInPlace(pursuitDirection);
+                    if (reservations) holdPosition(*reservations, currentTile, ticksPerStep);
+                    return;
+                }
+                if (reservations) {
+                    // 下一格在这一步期间被其他AI预留：原地让行 (占住当前格)，下一tick再试
+                    const std::uint64_t now = reservations->getCurrentTick();
+                    if (!reservations->isFree(pursuitNextTile, now, now + ticksPerStep, this)) {
+                        turnInPlace(pursuitDirection);
+                        holdPosition(*reservations, currentTile, ticksPerStep);
+                        return;
+                    }
+                    // 预留这一步占用的两格，以及路径上之后几格的到达时间段
+                    reservations->release(this);
+                    reservations->reserve(currentTile, now, now + ticksPerStep, this);
+                    for (size_t k = 0; k < static_cast<size_t>(ReservationTable::WINDOW_STEPS) &&
+                                       m_pursuitPathCursor + k < m_pursuitPath.size(); ++k) {
+                        reservations->reserve(m_pursuitPath[m_pursuitPathCursor + k],
+                                              now + k * ticksPerStep, now + (k + 2) * ticksPerStep, this);
+                    }
+                }
+                ++m_pursuitPathCursor; // 下面开始向该格移动
+            } else {
+                // 移动受阻等原因导致路径与当前位置脱节：作废，等待下一次规划
+                m_pursuitPath.clear();
+                m_pursuitPathCursor = 0;
+            }
+        }
+        if (!pursuingPlayer && currentTile == playerTile) {
+            sf::Vector2f dirToPlayer = playerTankRef->get_position() - get_position();
+            if (std::abs(dirToPlayer.x) > std::abs(dirToPlayer.y)) {
+                turnInPlace((dirToPlayer.x > 0) ? Direction::RIGHT : Direction::LEFT);
+            } else {
+                turnInPlace((dirToPlayer.y > 0) ? Direction::DOWN : Direction::UP);
+            }
+            return;
+        }
+    }
 
-    if (!m_hasStrategicTarget) { // 如果没有战略目标
+    if (pursuingPlayer) {
+        // 方向已由寻路器给出，直接进入下面的格子移动设置
+    } else if (!m_hasStrategicTarget) { // 如果没有战略目标
         // std::cout << "AITank (type '" << getTankType() << "'): No strategic target. Idling or random move." << std::endl;
         // 在此可以实现巡逻或随机移动逻辑
         // 简单示例：尝试随机选择一个可移动方向
@@ -168,9 +241,36 @@ void AITank::decideNextAction(const Map& map, const Tank* playerTankRef) {
         // return; // 如果没有战略目标，暂时只做随机方向选择，不立即移动
     } else { // 如果有战略目标
         sf::Vector2i currentTile = getCurrentTile(map);
-
+        Direction flowDirection;
+        sf::Vector2i flowNextTile;
+
+        // 目标是基地时优先使用共享流场：只比较4个邻格，O(1) 得到下一步
+        if (baseFlowField && baseFlowField->getGoal() == m_strategicTargetTileCoordinate &&
+            baseFlowField->getNextStep(currentTile, flowDirection, flowNextTile)) {
+            m_intendedDirectionForTileMove = flowDirection;
+            if (!map.isTileWalkable(flowNextTile.x, flowNextTile.y)) {
+                // 下一步是砖墙或基地本身：原地转向它，由自动射击打穿/攻击
+                turnInPlace(flowDirection);
+                if (reservations) holdPosition(*reservations, currentTile, ticksPerStep);
+                return;
+            }
+            if (reservations) {
+                // WHCA*：在预留表上做窗口化时空搜索，流场距离作为窗口之后的剩余代价
+                sf::Vector2i firstStep;
+                bool planned = reservations->planWindow(map, this, currentTile, ticksPerStep,
+                        [baseFlowField](sf::Vector2i tile) { return baseFlowField->getDistance(tile); }, firstStep);
+                if (!planned || firstStep == currentTile) {
+                    turnInPlace(flowDirection); // 等待让行，保持朝向前进方向
+                    m_nextDecisionTick = reservations->getCurrentTick() + std::max<std::uint64_t>(1, ticksPerStep / YIELD_RETRY_FRACTION);
+                    return;
+                }
+                sf::Vector2i step = firstStep - currentTile;
+                m_intendedDirectionForTileMove = (step.x < 0) ? Direction::LEFT : (step.x > 0) ? Direction::RIGHT
+                                               : (step.y < 0) ? Direction::UP : Direction::DOWN;
+            }
+        }
         // 如果已在目标瓦片 (例如基地)
-        if (currentTile.x == m_strategicTargetTileCoordinate.x && currentTile.y == m_strategicTargetTileCoordinate.y) {
+        else if (currentTile.x == m_strategicTargetTileCoordinate.x && currentTile.y == m_strategicTargetTileCoordinate.y) {
             // std::cout << "AITank (type '" << getTankType() << "'): Reached strategic target tile. Considering attack." << std::endl;
             // TODO: 在此加入攻击逻辑，例如调整方向对准基地并射击
             // 简单示例：尝试朝向玩家（如果玩家存在且在附近）或一个固定方向
@@ -322,13 +422,59 @@ void AITank::updateMovementBetweenTiles(sf::Time dt, const Map& map) {
         m_sprite.setPosition(m_position);         // 更新精灵位置
         m_isMovingToNextTile = false;             // 标记格子间移动完成
         // std::cout << "AITank (type '" << getTankType() << "') reached center of target tile." << std::endl;
-    } else if (actualNewPos == currentPos && !reachedTargetAxis && sf::Keyboard::isKeyPressed(sf::Keyboard::P)) { // 如果移动受阻 (位置未变) 且未到达目标轴
-        // (sf::Keyboard::isKeyPressed(sf::Keyboard::P) 是一个调试条件，可以移除)
+    } else if (actualNewPos == currentPos && !reachedTargetAxis) { // 如果移动受阻 (位置未变) 且未到达目标轴
         m_isMovingToNextTile = false; // 停止当前移动尝试，让AI重新决策
         // std::cout << "AITank (type '" << getTankType() << "') movement blocked before reaching target axis point." << std::endl;
     }
 }
 
+// 原地转向
+void AITank::turnInPlace(Direction direction) {
+    if (m_direction != direction) {
+        m_direction = direction;
+        m_currentFrame = 0; // 重置动画帧，让Tank::update去取新方向的纹理
+    }
+}
+
+// 原地等待
+void AITank::holdPosition(ReservationTable& reservations, sf::Vector2i tile, std::uint64_t ticksPerStep) {
+    reservations.holdTile(this, tile, ticksPerStep);
+    m_nextDecisionTick = reservations.getCurrentTick() + std::max<std::uint64_t>(1, ticksPerStep / YIELD_RETRY_FRACTION);
+}
+
+// 设置AI行为模式
+void AITank::setBehavior(AIBehavior behavior) {
+    m_behavior = behavior;
+    if (behavior == AIBehavior::HuntPlayer) {
+        if (!m_pursuitPlanner) m_pursuitPlanner = std::make_unique<DStarLite>();
+    } else {
+        m_pursuitPlanner.reset();
+        m_pursuitPath.clear();
+        m_pursuitPathCursor = 0;
+    }
+}
+
+// 重新规划追击路径
+void AITank::planPursuit(const Map& map, const Tank* playerTankRef) {
+    m_pursuitPathCursor = 0;
+    if (!m_pursuitPlanner || !playerTankRef || playerTankRef->isDestroyed() || isDestroyed() ||
+        map.getTileWidth() == 0 || map.getTileHeight() == 0) {
+        m_pursuitPath.clear();
+        return;
+    }
+    // 正在格子间移动时，从即将到达的格子出发规划，到达后即可接着走
+    sf::Vector2i start = getCurrentTile(map);
+    if (m_isMovingToNextTile) {
+        start = sf::Vector2i(static_cast<int>(m_pixelTargetForTileMove.x / map.getTileWidth()),
+                             static_cast<int>(m_pixelTargetForTileMove.y / map.getTileHeight()));
+    }
+    sf::Vector2i playerTile(static_cast<int>(playerTankRef->get_position().x / map.getTileWidth()),
+                            static_cast<int>(playerTankRef->get_position().y / map.getTileHeight()));
+    if (!m_pursuitPlanner->findPath(map, start, playerTile, m_pursuitPath)) {
+        m_pursuitPath.clear();
+    }
+}
+
 // 设置AI坦克的战略目标瓦片
 void AITank::setStrategicTargetTile(sf::Vector2i targetTile) {
     m_strategicTargetTileCoordinate = targetTile;
@@ -365,8 +511,8 @@ void AITank::activateSlowDebuff(float speedMultiplier, float attackSpeedFactor,
     m_slowDebuffDuration = duration;    // 设置debuff持续时间
     m_isSlowDebuffActive = true;        // 标记debuff为激活状态
 
-    std::cout << "AITank (type '" << getTankType() << "') SLOWED DOWN. Speed: " << getSpeed()
-              << ", Cooldown dist altered. Duration: " << duration.asSeconds() << "s" << std::endl;
+    LOG_DEBUG("AITank (type '" << getTankType() << "') SLOWED DOWN. Speed: " << getSpeed()
+              << ", Cooldown dist altered. Duration: " << duration.asSeconds() << "s");
 }
 
 
@@ -4,17 +4,28 @@
 // =========================================================================
 // 必要的头文件包含
 // =========================================================================
-#include "Tank.h"       // 包含基类 Tank 的定义
+#include "tank.h"       // 包含基类 Tank 的定义
 #include "Map.h"        // 包含 Map 类的定义 (用于 AI 决策和移动)
 #include <random>       // 用于随机数生成 (例如 m_rng)
 #include <string>       // 用于 std::string (作为 tankType)
-// Game.h 通常不在 AITank.h 中直接包含，以避免循环依赖，
-// Tank 基类的方法签名已经改变，需要 Game&，因此构造函数和update会接收它。
+#include <memory>       // 用于 std::unique_ptr (追击寻路器)
+#include <vector>       // 用于 std::vector (追击路径)
+// World.h 通常不在 AITank.h 中直接包含，以避免循环依赖，
+// Tank 基类的方法签名需要 World&，因此构造函数和update会接收它。
 
 // =========================================================================
 // 前向声明 (Forward Declarations)
 // =========================================================================
-class Game;             // Game 类，AITank 的行为可能需要与 Game 对象交互
+class World;            // World 类，AITank 的行为可能需要与模拟核心交互
+class FlowField;        // 共享的通往基地流场 (只读查询)
+class DStarLite;        // 追击玩家的增量寻路器 (仅追击型AI持有)
+class ReservationTable; // 时空预留表 (AI之间协同让行)
+
+// AI行为模式 (由 config.json 中 ai_types 的 "behavior" 字段决定)
+enum class AIBehavior : std::uint8_t {
+    AttackBase, // 沿共享流场进攻基地 (默认)
+    HuntPlayer  // 用 D* Lite 增量寻路追击玩家 (经 World 的寻路请求队列)，没有可用路径时改为进攻基地
+};
 
 class AITank : public Tank {
 public:
@@ -25,35 +36,42 @@ public:
     //   startPosition - AI坦克的初始位置
     //   direction - AI坦克的初始方向
     //   tankType - AI坦克的类型字符串 (例如 "ai_default", "ai_fast")
-    //   game - 对Game对象的引用 (用于基类构造和潜在的AI特定逻辑)
+    //   world - 对World对象的引用 (用于基类构造和潜在的AI特定逻辑)
     //   baseSpeed - AI坦克的基础速度
     //   baseHealth - AI坦克的基础生命值
     //   baseAttack - AI坦克的基础攻击力
     //   frameW - 纹理帧宽度
     //   frameH - 纹理帧高度
     //   scoreValue - 击毁此AI坦克获得的分数
+    //   rngSeed - AI随机行为 (属性浮动、射击冷却) 的种子
     AITank(sf::Vector2f startPosition,
            Direction direction,
            const std::string& tankType,
-           Game& game,
+           World& world,
            float baseSpeed,
            int baseHealth,
            int baseAttack,
            int frameW,
            int frameH,
-           int scoreValue);
+           int scoreValue,
+           unsigned int rngSeed = std::random_device{}());
+    ~AITank() override; // DStarLite 为不完整类型，析构函数在 .cpp 中定义
 
     // =========================================================================
-    // 核心AI逻辑方法 (由Game类在主循环中调用)
+    // 核心AI逻辑方法 (由World类在模拟步进中调用)
     // =========================================================================
     // AI决策：决定下一步要朝哪个方向移动（或者是否射击等）
-    void decideNextAction(const Map& map, const Tank* playerTankRef);
+    // baseFlowField: 共享的通往基地的流场；战略目标为基地时按流场走，为空时退回简单寻路
+    // reservations: 时空预留表；提供时进攻基地的AI以流场距离为启发值做窗口化时空搜索，避开其他AI预留的格子，
+    //               追击型AI在下一格被占用时原地让行
+    void decideNextAction(const Map& map, const Tank* playerTankRef, const FlowField* baseFlowField = nullptr,
+                          ReservationTable* reservations = nullptr);
 
     // 每帧调用，处理正在进行的格子间平滑移动
     void updateMovementBetweenTiles(sf::Time dt, const Map& map);
 
     // 覆盖基类的 update 方法，处理AI特有的更新逻辑 (如射击计时器、debuff)
-    void update(sf::Time dt, Game& game) override;
+    void update(sf::Time dt, World& world) override;
 
     // =========================================================================
     // AI状态查询与控制
@@ -61,6 +79,21 @@ public:
     // 设置 AI 坦克的战略目标瓦片坐标 (例如，基地位置)
     void setStrategicTargetTile(sf::Vector2i targetTile);
 
+    // 设置/查询行为模式 (切换为 HuntPlayer 时创建寻路器)
+    void setBehavior(AIBehavior behavior);
+    AIBehavior getBehavior() const { return m_behavior; }
+
+    // =========================================================================
+    // 追击寻路 (由 PathRequestQueue 按每tick预算调用)
+    // =========================================================================
+    void planPursuit(const Map& map, const Tank* playerTankRef); // 重新规划到玩家的路径 (移动中时从目标格出发)
+    bool hasPursuitPath() const { return m_pursuitPathCursor < m_pursuitPath.size(); } // 是否还有旧路径可走
+    bool isPathRequestPending() const { return m_pathRequestPending; }
+    void setPathRequestPending(bool pending) { m_pathRequestPending = pending; }
+
+    // 在预留表上让行等待时，到此tick之前不再重新决策 (也不提交寻路请求)
+    bool isYielding(std::uint64_t tick) const { return tick < m_nextDecisionTick; }
+
     // 检查 AI 坦克当前是否正在进行格子间的移动
     bool isMoving() const { return m_isMovingToNextTile; }
 
@@ -91,22 +124,28 @@ private:
     // =========================================================================
     bool m_isMovingToNextTile;              // 标记坦克当前是否正在从一个格子移动到下一个格子
     sf::Vector2f m_pixelTargetForTileMove;  // 当前格子间移动的目标像素位置 (下一个格子的中心)
-    Direction m_intendedDirectionForTileMove; // 本次格子移动的预定方向
+    Direction m_intendedDirectionForTileMove = Direction::UP; // 本次格子移动的预定方向
 
     // =========================================================================
     // AI 战略目标相关成员
     // =========================================================================
-    sf::Vector2i m_strategicTargetTileCoordinate; // AI 的长期战略目标瓦片坐标
-    bool m_hasStrategicTarget;                    // 标记 AI 是否有一个有效的战略目标
+    sf::Vector2i m_strategicTargetTileCoordinate{-1, -1}; // AI 的长期战略目标瓦片坐标
+    bool m_hasStrategicTarget = false;            // 标记 AI 是否有一个有效的战略目标
+    AIBehavior m_behavior = AIBehavior::AttackBase;
+    std::unique_ptr<DStarLite> m_pursuitPlanner;  // 追击玩家的寻路状态 (跨决策保留，增量修复)
+    std::vector<sf::Vector2i> m_pursuitPath;      // 最近一次规划的路径 (不含出发格)，排队等待新规划时沿它行进
+    size_t m_pursuitPathCursor = 0;               // 下一步要进入的路径下标
+    bool m_pathRequestPending = false;            // 是否已在寻路请求队列中
+    std::uint64_t m_nextDecisionTick = 0;         // 让行等待结束的tick (见 isYielding)
 
     // =========================================================================
     // AI Debuff 相关状态存储
     // =========================================================================
-    float m_baseSpeedForDebuff;         // 存储应用 debuff 前的基础速度 (用于恢复)
+    float m_baseSpeedForDebuff = 0.f;   // 存储应用 debuff 前的基础速度 (用于恢复)
     std::uniform_real_distribution<float> m_originalCooldownDistribution; // 存储原始的射击冷却分布 (用于恢复)
-    bool m_wasOriginalDistStored;       // 标记原始冷却分布是否已存储
+    bool m_wasOriginalDistStored = false; // 标记原始冷却分布是否已存储
     sf::Time m_slowDebuffDuration;      // 减速 debuff 的剩余持续时间
-    bool m_isSlowDebuffActive;          // 标记减速 debuff 是否激活
+    bool m_isSlowDebuffActive = false;  // 标记减速 debuff 是否激活
 
     // =========================================================================
     // AI 属性随机化相关常量
@@ -127,6 +166,13 @@ private:
     // 获取 AI 坦克当前所在的瓦片坐标
     sf::Vector2i getCurrentTile(const Map& map) const;
 
+    // 原地转向 (不移动)，用于对准砖墙/基地/玩家开火
+    void turnInPlace(Direction direction);
+
+    // 原地等待：占住当前格，并在 1/YIELD_RETRY_FRACTION 步之后再重新决策
+    void holdPosition(ReservationTable& reservations, sf::Vector2i tile, std::uint64_t ticksPerStep);
+    static constexpr std::uint64_t YIELD_RETRY_FRACTION = 4;
+
     // 辅助方法，用于在一个范围内生成随机值 (用于属性随机化)
     float getRandomValue(float base, float factor);
     int getRandomValueInt(int base, float factor);
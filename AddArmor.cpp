@@ -6,13 +6,13 @@
 
 #include "AddArmor.h"
 #include "tank.h"       // 确保包含了 Tank 类的头文件
-#include "game.h"       // Game 头文件可能需要，如果道具效果需要与游戏状态交互
+#include "World.h"      // World 头文件可能需要，如果道具效果需要与游戏状态交互
 
-AddArmor::AddArmor(sf::Vector2f pos, const sf::Texture &texture) : Tools(pos, texture) {
-    std::cout << "Add Armor created in  (" << pos.x << ", " << pos.y << ")" << std::endl;
+AddArmor::AddArmor(sf::Vector2f pos, const TextureRegion &texture) : Tools(pos, texture) {
+    LOG_DEBUG("Add Armor created in  (" << pos.x << ", " << pos.y << ")");
 }
 
-void AddArmor::applyEffect(Tank &tank, Game &gameContext) {
+void AddArmor::applyEffect(Tank &tank, World& worldContext) {
     // 假设 Tank 类有 getArmor 和 setArmor 方法，以及一个表示护甲上限的机制
     // 并且护甲上限为 1
     int currentArmor = tank.getArmor(); // 假设 tank.getArmor() 获取当前护甲
@@ -20,12 +20,12 @@ void AddArmor::applyEffect(Tank &tank, Game &gameContext) {
 
     if (currentArmor < maxArmor) {
         tank.setArmor(currentArmor + 1); // 假设 tank.setArmor() 设置新护甲
-        std::cout << "Tank armor increased to: " << tank.getArmor() << std::endl;
+        LOG_DEBUG("Tank armor increased to: " << tank.getArmor());
     } else {
-        std::cout << "Tank armor is already at maximum." << std::endl;
+        LOG_DEBUG("Tank armor is already at maximum.");
     }
 
     // 道具使用后通常会失效
     this->setActive(false);
-    std::cout << "AddArmor effect applied. Props deactivated." << std::endl;
+    LOG_DEBUG("AddArmor effect applied. Props deactivated.");
 }
\ No newline at end of file
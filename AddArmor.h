@@ -6,13 +6,13 @@
 #define TANKS_ADDARMOR_H
 
 #include "Tools.h"
-#include "game.h"
+#include "World.h"
 
 class AddArmor:public Tools {
 public:
-    AddArmor(sf::Vector2f pos, const sf::Texture &texture);
+    AddArmor(sf::Vector2f pos, const TextureRegion &texture);
 
-    void applyEffect(Tank &tank, Game &gameContext) override;
+    void applyEffect(Tank &tank, World& worldContext) override;
 
 };
 #endif //TANKS_ADDARMOR_H
@@ -4,11 +4,11 @@
 
 #include "AddAttack.h"
 
-AddAttack::AddAttack(sf::Vector2f pos, const sf::Texture &texture) : Tools(pos, texture) {
+AddAttack::AddAttack(sf::Vector2f pos, const TextureRegion &texture) : Tools(pos, texture) {
 
 }
 
-void AddAttack::applyEffect(Tank &tank, Game &gameContext) {
+void AddAttack::applyEffect(Tank &tank, World& worldContext) {
     float multiplier = 2.0f;
     sf::Time duration = sf::seconds(5.0f);
 
@@ -16,5 +16,5 @@ void AddAttack::applyEffect(Tank &tank, Game &gameContext) {
 
     this->setActive(false);
 
-    std::cout << "AddAttack effect applied" << std::endl;
+    LOG_DEBUG("AddAttack effect applied");
 }
@@ -6,13 +6,13 @@
 #define TANKS_ADDATTACK_H
 
 #include "Tools.h"
-#include "game.h"
+#include "World.h"
 
 class AddAttack:public Tools {
     public:
-         AddAttack(sf::Vector2f pos, const sf::Texture &texture);
+         AddAttack(sf::Vector2f pos, const TextureRegion &texture);
 
-         void applyEffect(Tank &tank,Game& gameContext) override;
+         void applyEffect(Tank &tank,World& worldContext) override;
 
 };
 
@@ -1,12 +1,12 @@
 #include "AddAttackSpeed.h"
-#include "Tank.h"   // 确保包含了 Tank 类的头文件
-#include "Game.h"   // Game 头文件
+#include "tank.h"   // 确保包含了 Tank 类的头文件
+#include "World.h"  // World 头文件
 
-AddAttackSpeed::AddAttackSpeed(sf::Vector2f pos, const sf::Texture &texture) : Tools(pos, texture) {
+AddAttackSpeed::AddAttackSpeed(sf::Vector2f pos, const TextureRegion &texture) : Tools(pos, texture) {
     // 构造函数内容
 }
 
-void AddAttackSpeed::applyEffect(Tank &tank, Game &gameContext) {
+void AddAttackSpeed::applyEffect(Tank &tank, World& worldContext) {
     // 攻速 * 1.5 意味着射击冷却时间变为原来的 1 / 1.5 倍
     float cooldownMultiplier = 1.0f / 1.5f;
     sf::Time duration = sf::seconds(3.0f);
@@ -14,5 +14,5 @@ void AddAttackSpeed::applyEffect(Tank &tank, Game &gameContext) {
     tank.activateAttackSpeedBuff(cooldownMultiplier, duration); // 假设Tank类有此方法
 
     this->setActive(false); // 道具使用后失效
-    std::cout << "AddAttackSpeed effect applied. Tank attack speed will be *1.5 for 3 seconds. Props deactivated." << std::endl;
+    LOG_DEBUG("AddAttackSpeed effect applied. Tank attack speed will be *1.5 for 3 seconds. Props deactivated.");
 }
\ No newline at end of file
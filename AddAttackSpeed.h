@@ -11,9 +11,9 @@
 class AddAttackSpeed: public Tools {
 
 public:
-    AddAttackSpeed(sf::Vector2f pos, const sf::Texture &texture);
+    AddAttackSpeed(sf::Vector2f pos, const TextureRegion &texture);
 
-    void applyEffect(Tank &tank,Game& gameContext) override;
+    void applyEffect(Tank &tank,World& worldContext) override;
 };
 
 
@@ -10,9 +10,9 @@
 
 class AddSpeed:public Tools {
 public:
-    AddSpeed(sf::Vector2f pos, const sf::Texture &texture);
+    AddSpeed(sf::Vector2f pos, const TextureRegion &texture);
 
-    void applyEffect(Tank &tank, Game &gameContext) override;
+    void applyEffect(Tank &tank, World& worldContext) override;
 
 };
 
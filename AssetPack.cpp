@@ -0,0 +1,251 @@
+// AssetPack.cpp
+#include "AssetPack.h"
+#include "Log.h"
+#include <cstring>   // std::memcpy, std::memcmp
+#include <fstream>
+
+#ifdef _WIN32
+#include "windows.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char PACK_MAGIC[8] = {'T', 'A', 'N', 'K', 'P', 'A', 'C', 'K'};
+    const size_t HEADER_BYTES = 32;
+    const size_t PAGE_RECORD_BYTES = 16;  // 宽 u32 + 高 u32 + 偏移 u64
+    const size_t ENTRY_RECORD_BYTES = 24; // 类型 u8 + 方向 u8 + 键名长度 u16 + 页 i32 + 矩形 4*i32
+    const size_t PIXEL_ALIGNMENT = 16;
+
+    size_t alignUp(size_t value, size_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+    template <typename T>
+    void putValue(std::vector<char>& buffer, size_t offset, T value) {
+        std::memcpy(buffer.data() + offset, &value, sizeof(T));
+    }
+
+    template <typename T>
+    T getValue(const std::uint8_t* data, size_t offset) {
+        T value;
+        std::memcpy(&value, data + offset, sizeof(T)); // 映射内存不保证对齐
+        return value;
+    }
+}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+// =========================================================================
+// 写出
+// =========================================================================
+bool AssetPack::write(const std::string& path, const std::string& configText,
+                      const std::vector<sf::Image>& pages, const std::vector<AssetPackEntry>& entries) {
+    // 1. 计算各段偏移
+    const size_t pageTableOffset = alignUp(HEADER_BYTES + configText.size(), 8);
+    const size_t entryTableOffset = pageTableOffset + pages.size() * PAGE_RECORD_BYTES;
+    size_t entryTableBytes = 0;
+    for (const AssetPackEntry& entry : entries) {
+        if (entry.key.size() > UINT16_MAX) {
+            LOG_ERROR("AssetPack::write() - Error: Key '" << entry.key.substr(0, 32) << "...' is too long.");
+            return false;
+        }
+        entryTableBytes += ENTRY_RECORD_BYTES + entry.key.size();
+    }
+    std::vector<size_t> pixelOffsets(pages.size());
+    size_t fileSize = entryTableOffset + entryTableBytes;
+    for (size_t i = 0; i < pages.size(); ++i) {
+        fileSize = alignUp(fileSize, PIXEL_ALIGNMENT);
+        pixelOffsets[i] = fileSize;
+        fileSize += static_cast<size_t>(pages[i].getSize().x) * pages[i].getSize().y * 4;
+    }
+
+    // 2. 文件头、配置与两张表一次写入缓冲
+    std::vector<char> head(entryTableOffset + entryTableBytes, 0);
+    std::memcpy(head.data(), PACK_MAGIC, sizeof(PACK_MAGIC));
+    putValue<std::uint32_t>(head, 8, VERSION);
+    putValue<std::uint32_t>(head, 12, static_cast<std::uint32_t>(configText.size()));
+    putValue<std::uint32_t>(head, 16, static_cast<std::uint32_t>(pages.size()));
+    putValue<std::uint32_t>(head, 20, static_cast<std::uint32_t>(entries.size()));
+    putValue<std::uint64_t>(head, 24, static_cast<std::uint64_t>(fileSize));
+    std::memcpy(head.data() + HEADER_BYTES, configText.data(), configText.size());
+
+    for (size_t i = 0; i < pages.size(); ++i) {
+        const size_t record = pageTableOffset + i * PAGE_RECORD_BYTES;
+        putValue<std::uint32_t>(head, record, pages[i].getSize().x);
+        putValue<std::uint32_t>(head, record + 4, pages[i].getSize().y);
+        putValue<std::uint64_t>(head, record + 8, static_cast<std::uint64_t>(pixelOffsets[i]));
+    }
+    size_t record = entryTableOffset;
+    for (const AssetPackEntry& entry : entries) {
+        putValue<std::uint8_t>(head, record, entry.isTankFrame ? 1 : 0);
+        putValue<std::uint8_t>(head, record + 1, static_cast<std::uint8_t>(entry.direction));
+        putValue<std::uint16_t>(head, record + 2, static_cast<std::uint16_t>(entry.key.size()));
+        putValue<std::int32_t>(head, record + 4, entry.page);
+        putValue<std::int32_t>(head, record + 8, entry.rect.left);
+        putValue<std::int32_t>(head, record + 12, entry.rect.top);
+        putValue<std::int32_t>(head, record + 16, entry.rect.width);
+        putValue<std::int32_t>(head, record + 20, entry.rect.height);
+        std::memcpy(head.data() + record + ENTRY_RECORD_BYTES, entry.key.data(), entry.key.size());
+        record += ENTRY_RECORD_BYTES + entry.key.size();
+    }
+
+    // 3. 依次写出页像素 (按对齐要求补零)
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_ERROR("AssetPack::write() - Error: Failed to open '" << path << "' for writing.");
+        return false;
+    }
+    file.write(head.data(), static_cast<std::streamsize>(head.size()));
+    size_t written = head.size();
+    const char zeros[PIXEL_ALIGNMENT] = {};
+    for (size_t i = 0; i < pages.size(); ++i) {
+        file.write(zeros, static_cast<std::streamsize>(pixelOffsets[i] - written));
+        const size_t pixelBytes = static_cast<size_t>(pages[i].getSize().x) * pages[i].getSize().y * 4;
+        if (pixelBytes > 0) file.write(reinterpret_cast<const char*>(pages[i].getPixelsPtr()), static_cast<std::streamsize>(pixelBytes));
+        written = pixelOffsets[i] + pixelBytes;
+    }
+    if (!file.good()) {
+        LOG_ERROR("AssetPack::write() - Error: Failed while writing '" << path << "'.");
+        return false;
+    }
+    return true;
+}
+
+// =========================================================================
+// 内存映射打开
+// =========================================================================
+bool AssetPack::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOG_ERROR("AssetPack::open() - Error: Failed to open '" << path << "'.");
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        LOG_ERROR("AssetPack::open() - Error: '" << path << "' is empty or unreadable.");
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        LOG_ERROR("AssetPack::open() - Error: Failed to map '" << path << "'.");
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_data = static_cast<const std::uint8_t*>(view);
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR("AssetPack::open() - Error: Failed to open '" << path << "'.");
+        return false;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0) {
+        LOG_ERROR("AssetPack::open() - Error: '" << path << "' is empty or unreadable.");
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // 映射建立后文件描述符即可关闭
+    if (view == MAP_FAILED) {
+        LOG_ERROR("AssetPack::open() - Error: Failed to map '" << path << "'.");
+        return false;
+    }
+    m_data = static_cast<const std::uint8_t*>(view);
+    m_size = static_cast<size_t>(fileStat.st_size);
+#endif
+
+    if (!parse(path)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void AssetPack::close() {
+    if (m_data) {
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+        CloseHandle(static_cast<HANDLE>(m_fileHandle));
+        m_fileHandle = nullptr;
+        m_mappingHandle = nullptr;
+#else
+        munmap(const_cast<std::uint8_t*>(m_data), m_size);
+#endif
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_configText = std::string_view();
+    m_pages.clear();
+    m_entries.clear();
+}
+
+bool AssetPack::parse(const std::string& path) {
+    auto fail = [&path](const char* reason) {
+        LOG_ERROR("AssetPack::open() - Error: '" << path << "' is not a valid asset pack (" << reason << ").");
+        return false;
+    };
+    if (m_size < HEADER_BYTES || std::memcmp(m_data, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0) return fail("bad header");
+    if (getValue<std::uint32_t>(m_data, 8) != VERSION) return fail("unsupported version, rebuild it with TanksPackBuilder");
+    const size_t configBytes = getValue<std::uint32_t>(m_data, 12);
+    const size_t pageCount = getValue<std::uint32_t>(m_data, 16);
+    const size_t entryCount = getValue<std::uint32_t>(m_data, 20);
+    if (getValue<std::uint64_t>(m_data, 24) != m_size) return fail("truncated file");
+
+    // 各表的边界都先检查再读取，损坏的文件不会越界访问
+    const size_t pageTableOffset = alignUp(HEADER_BYTES + configBytes, 8);
+    if (pageTableOffset > m_size || pageCount > (m_size - pageTableOffset) / PAGE_RECORD_BYTES) return fail("page table out of range");
+    m_configText = std::string_view(reinterpret_cast<const char*>(m_data + HEADER_BYTES), configBytes);
+
+    m_pages.resize(pageCount);
+    for (size_t i = 0; i < pageCount; ++i) {
+        const size_t record = pageTableOffset + i * PAGE_RECORD_BYTES;
+        AssetPackPage& page = m_pages[i];
+        page.width = getValue<std::uint32_t>(m_data, record);
+        page.height = getValue<std::uint32_t>(m_data, record + 4);
+        const std::uint64_t pixelOffset = getValue<std::uint64_t>(m_data, record + 8);
+        const std::uint64_t pixelBytes = static_cast<std::uint64_t>(page.width) * page.height * 4;
+        if (pixelOffset > m_size || pixelBytes > m_size - pixelOffset) return fail("page pixels out of range");
+        page.pixels = m_data + pixelOffset;
+    }
+
+    size_t record = pageTableOffset + pageCount * PAGE_RECORD_BYTES;
+    m_entries.resize(entryCount);
+    for (size_t i = 0; i < entryCount; ++i) {
+        if (ENTRY_RECORD_BYTES > m_size - record) return fail("region table out of range");
+        const size_t keyLength = getValue<std::uint16_t>(m_data, record + 2);
+        if (keyLength > m_size - record - ENTRY_RECORD_BYTES) return fail("region table out of range");
+
+        AssetPackEntry& entry = m_entries[i];
+        entry.isTankFrame = getValue<std::uint8_t>(m_data, record) != 0;
+        const std::uint8_t direction = getValue<std::uint8_t>(m_data, record + 1);
+        if (direction > static_cast<std::uint8_t>(Direction::DOWN)) return fail("bad direction");
+        entry.direction = static_cast<Direction>(direction);
+        entry.page = getValue<std::int32_t>(m_data, record + 4);
+        entry.rect = sf::IntRect(getValue<std::int32_t>(m_data, record + 8), getValue<std::int32_t>(m_data, record + 12),
+                                 getValue<std::int32_t>(m_data, record + 16), getValue<std::int32_t>(m_data, record + 20));
+        entry.key.assign(reinterpret_cast<const char*>(m_data + record + ENTRY_RECORD_BYTES), keyLength);
+        record += ENTRY_RECORD_BYTES + keyLength;
+
+        if (entry.page < 0 || static_cast<size_t>(entry.page) >= pageCount) return fail("region refers to a missing page");
+        const AssetPackPage& page = m_pages[static_cast<size_t>(entry.page)];
+        if (entry.rect.left < 0 || entry.rect.top < 0 || entry.rect.width <= 0 || entry.rect.height <= 0 ||
+            static_cast<unsigned>(entry.rect.left + entry.rect.width) > page.width ||
+            static_cast<unsigned>(entry.rect.top + entry.rect.height) > page.height) {
+            return fail("region outside its page");
+        }
+    }
+    return true;
+}
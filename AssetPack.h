@@ -0,0 +1,79 @@
+#ifndef TANKS_ASSETPACK_H
+#define TANKS_ASSETPACK_H
+
+// =========================================================================
+// 必要的头文件包含
+// =========================================================================
+#include <SFML/Graphics.hpp> // sf::Image, sf::IntRect
+#include "common.h"          // Direction
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// =========================================================================
+// AssetPack: 单文件二进制资源包
+// =========================================================================
+// 由 TanksPackBuilder 生成，包含：配置 JSON 原文 + 已解码、已按图集排好的页像素 (RGBA8)
+// + 区域表 (纹理键名/坦克帧 -> 页 + 子矩形)。
+// 游戏启动时整个文件以只读内存映射打开，页像素直接从映射内存上传为纹理，
+// 不再依赖 config.json 中的图片路径，也不再解码 PNG。
+//
+// 文件布局 (本机字节序，即小端)：
+//   [文件头 32 字节] magic "TANKPACK" | 版本 | 配置字节数 | 页数 | 区域数 | 文件总长
+//   [配置 JSON 原文]
+//   [页表]   每页 { 宽, 高, 像素偏移 } (8 字节对齐)
+//   [区域表] 每项 { 类型, 方向, 键名长度, 页, x, y, w, h } + 键名
+//   [页像素] 每页 宽*高*4 字节 (16 字节对齐)
+struct AssetPackPage {
+    unsigned width = 0;
+    unsigned height = 0;
+    const std::uint8_t* pixels = nullptr; // 指向映射内存 (写入时不使用)
+};
+
+struct AssetPackEntry {
+    std::string key;                     // 纹理键名；坦克帧时为坦克类型
+    bool isTankFrame = false;            // 坦克帧按出现顺序即为帧号
+    Direction direction = Direction::UP; // 仅坦克帧使用
+    int page = -1;
+    sf::IntRect rect;
+};
+
+class AssetPack {
+public:
+    static const std::uint32_t VERSION = 1;
+
+    AssetPack() = default;
+    ~AssetPack();
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    bool open(const std::string& path); // 内存映射并校验整个文件；失败时打印原因并返回 false
+    void close();                       // 解除映射 (页纹理上传后即可关闭)
+    bool isOpen() const { return m_data != nullptr; }
+
+    std::string_view getConfigText() const { return m_configText; }
+    const std::vector<AssetPackPage>& getPages() const { return m_pages; }
+    const std::vector<AssetPackEntry>& getEntries() const { return m_entries; }
+    size_t getFileSize() const { return m_size; }
+
+    // 写出资源包 (pages 的下标与 entries 中的 page 对应)
+    static bool write(const std::string& path, const std::string& configText,
+                      const std::vector<sf::Image>& pages, const std::vector<AssetPackEntry>& entries);
+
+private:
+    bool parse(const std::string& path); // 校验并解析映射内存中的各个表
+
+    const std::uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#endif
+    std::string_view m_configText;
+    std::vector<AssetPackPage> m_pages;
+    std::vector<AssetPackEntry> m_entries;
+};
+
+#endif //TANKS_ASSETPACK_H
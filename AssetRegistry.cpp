@@ -0,0 +1,36 @@
+// AssetRegistry.cpp
+#include "AssetRegistry.h"
+
+namespace {
+    int intern(std::unordered_map<std::string, int>& handles, std::vector<std::string>& names, const std::string& name) {
+        auto [it, inserted] = handles.emplace(name, static_cast<int>(names.size()));
+        if (inserted) names.push_back(name);
+        return it->second;
+    }
+
+    int find(const std::unordered_map<std::string, int>& handles, const std::string& name) {
+        auto it = handles.find(name);
+        return it != handles.end() ? it->second : INVALID_ASSET_HANDLE;
+    }
+
+    const std::string& nameOf(const std::vector<std::string>& names, int handle) {
+        static const std::string unknown = "<unknown>";
+        return (handle >= 0 && static_cast<size_t>(handle) < names.size()) ? names[static_cast<size_t>(handle)] : unknown;
+    }
+}
+
+TextureHandle AssetRegistry::internTexture(const std::string& key) { return intern(m_textureHandles, m_textureNames, key); }
+TankTypeHandle AssetRegistry::internTankType(const std::string& name) { return intern(m_tankTypeHandles, m_tankTypeNames, name); }
+
+void AssetRegistry::clear() {
+    m_textureHandles.clear();
+    m_textureNames.clear();
+    m_tankTypeHandles.clear();
+    m_tankTypeNames.clear();
+}
+
+TextureHandle AssetRegistry::findTexture(const std::string& key) const { return find(m_textureHandles, key); }
+TankTypeHandle AssetRegistry::findTankType(const std::string& name) const { return find(m_tankTypeHandles, name); }
+
+const std::string& AssetRegistry::getTextureName(TextureHandle handle) const { return nameOf(m_textureNames, handle); }
+const std::string& AssetRegistry::getTankTypeName(TankTypeHandle handle) const { return nameOf(m_tankTypeNames, handle); }
@@ -0,0 +1,42 @@
+#ifndef TANKS_ASSETREGISTRY_H
+#define TANKS_ASSETREGISTRY_H
+
+// =========================================================================
+// 必要的头文件包含
+// =========================================================================
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 纹理键名 / 坦克类型在加载时解析出的稠密编号；热路径上按编号直接索引数组，不再做字符串查找
+using TextureHandle = int;
+using TankTypeHandle = int;
+const int INVALID_ASSET_HANDLE = -1; // 未登记的名字 (或无界面模式下没有任何资源)
+
+// =========================================================================
+// AssetRegistry: 名字 -> 稠密整数编号
+// =========================================================================
+// 加载时 intern*() 登记所有名字，编号从0开始连续分配；之后只读。
+// find*() 只应在加载或初始化时调用，把结果保存在实体上。
+class AssetRegistry {
+public:
+    TextureHandle internTexture(const std::string& key);     // 已登记时返回原编号
+    TankTypeHandle internTankType(const std::string& name);
+    void clear();
+
+    TextureHandle findTexture(const std::string& key) const; // 未登记时返回 INVALID_ASSET_HANDLE
+    TankTypeHandle findTankType(const std::string& name) const;
+
+    const std::string& getTextureName(TextureHandle handle) const;   // 日志用
+    const std::string& getTankTypeName(TankTypeHandle handle) const;
+    size_t getTextureCount() const { return m_textureNames.size(); }
+    size_t getTankTypeCount() const { return m_tankTypeNames.size(); }
+
+private:
+    std::unordered_map<std::string, int> m_textureHandles;
+    std::vector<std::string> m_textureNames;
+    std::unordered_map<std::string, int> m_tankTypeHandles;
+    std::vector<std::string> m_tankTypeNames;
+};
+
+#endif //TANKS_ASSETREGISTRY_H
@@ -0,0 +1,129 @@
+// BulletSystem.cpp
+#include "BulletSystem.h"
+#include <algorithm>
+
+namespace {
+
+// 位置积分内核。__restrict 只有写在函数参数上 GCC 才会采信；写在局部指针上时
+// 六个数组之间的别名检查超出上限，循环不会被向量化
+void integratePositions(float* __restrict posX, float* __restrict posY,
+                        float* __restrict prevX, float* __restrict prevY,
+                        const float* __restrict velX, const float* __restrict velY,
+                        size_t count, float dtSeconds) {
+    for (size_t i = 0; i < count; ++i) {
+        prevX[i] = posX[i];
+        prevY[i] = posY[i];
+        posX[i] += velX[i] * dtSeconds;
+        posY[i] += velY[i] * dtSeconds;
+    }
+}
+
+} // namespace
+
+// =========================================================================
+// 容量与生命周期
+// =========================================================================
+void BulletSystem::configure(const BulletPoolConfig& config) {
+    m_config = config;
+    m_config.maxSize = std::max<size_t>(m_config.maxSize, 1);
+    m_config.initialSize = std::min(m_config.initialSize, m_config.maxSize);
+    m_config.growthStep = std::max<size_t>(m_config.growthStep, 1);
+
+    clear();
+    if (m_config.initialSize > capacity()) {
+        resizeTo(m_config.initialSize);
+    }
+}
+
+void BulletSystem::clear() {
+    m_activeCount = 0; // 数组容量保留，下一局从下标 0 开始发射 (结果可复现)
+}
+
+bool BulletSystem::spawn(sf::Vector2f position, Direction direction, sf::Vector2f flyDirection,
+                         int damage, float speed, int type) {
+    if (m_activeCount == capacity() && !grow()) {
+        ++m_stats.rejectedSpawns;
+        return false;
+    }
+
+    const size_t index = m_activeCount++;
+    m_stats.highWaterMark = std::max(m_stats.highWaterMark, m_activeCount);
+
+    sf::Vector2f velocity = normalize(flyDirection) * speed;
+    m_posX[index] = position.x;
+    m_posY[index] = position.y;
+    m_prevX[index] = position.x; // 新发射的子弹不做插值
+    m_prevY[index] = position.y;
+    m_velX[index] = velocity.x;
+    m_velY[index] = velocity.y;
+    m_damage[index] = damage;
+    m_type[index] = type;
+    m_direction[index] = static_cast<std::uint8_t>(direction);
+    return true;
+}
+
+void BulletSystem::kill(size_t index) {
+    if (index >= m_activeCount) return;
+
+    // 交换删除：末尾子弹的数据搬到 index，紧凑区保持连续
+    const size_t last = --m_activeCount;
+    if (index != last) {
+        m_posX[index] = m_posX[last];
+        m_posY[index] = m_posY[last];
+        m_prevX[index] = m_prevX[last];
+        m_prevY[index] = m_prevY[last];
+        m_velX[index] = m_velX[last];
+        m_velY[index] = m_velY[last];
+        m_damage[index] = m_damage[last];
+        m_type[index] = m_type[last];
+        m_direction[index] = m_direction[last];
+    }
+}
+
+bool BulletSystem::grow() {
+    size_t current = capacity();
+    if (current >= m_config.maxSize) {
+        return false;
+    }
+    size_t target = (m_config.growth == BulletPoolGrowth::Double)
+                    ? std::max<size_t>(current * 2, 1)
+                    : current + m_config.growthStep;
+    resizeTo(std::min(target, m_config.maxSize));
+    ++m_stats.growthEvents;
+    return true;
+}
+
+void BulletSystem::resizeTo(size_t newSize) {
+    m_posX.resize(newSize, 0.f);
+    m_posY.resize(newSize, 0.f);
+    m_prevX.resize(newSize, 0.f);
+    m_prevY.resize(newSize, 0.f);
+    m_velX.resize(newSize, 0.f);
+    m_velY.resize(newSize, 0.f);
+    m_damage.resize(newSize, 0);
+    m_type.resize(newSize, 0);
+    m_direction.resize(newSize, static_cast<std::uint8_t>(Direction::UP));
+}
+
+// =========================================================================
+// 模拟
+// =========================================================================
+void BulletSystem::update(sf::Time dt) {
+    // 存活子弹紧凑存放在 [0, m_activeCount)：连续访问、无间接下标，编译器可自动向量化
+    integratePositions(m_posX.data(), m_posY.data(), m_prevX.data(), m_prevY.data(),
+                       m_velX.data(), m_velY.data(), m_activeCount, dt.asSeconds());
+}
+
+// =========================================================================
+// 碰撞盒
+// =========================================================================
+sf::FloatRect BulletSystem::getBounds(size_t index) const {
+    const sf::Vector2f& size = m_hitboxSize[m_direction[index]];
+    return sf::FloatRect(m_posX[index] - size.x / 2.f, m_posY[index] - size.y / 2.f, size.x, size.y);
+}
+
+void BulletSystem::setHitboxSize(Direction direction, sf::Vector2f size) {
+    if (size.x > 0.f && size.y > 0.f) {
+        m_hitboxSize[static_cast<size_t>(direction)] = size;
+    }
+}
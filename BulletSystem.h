@@ -0,0 +1,131 @@
+#ifndef TANKS_BULLETSYSTEM_H
+#define TANKS_BULLETSYSTEM_H
+
+// =========================================================================
+// 必要的头文件包含
+// =========================================================================
+#include <SFML/Graphics.hpp> // sf::Vector2f, sf::FloatRect, sf::Time
+#include <cmath>             // 包含数学函数，例如 sqrt 用于向量归一化
+#include <cstdint>
+#include <vector>
+#include "common.h"          // 包含通用定义，例如 Direction 枚举
+
+// =========================================================================
+// 辅助函数
+// =========================================================================
+// 向量归一化：将给定的二维向量转换为单位向量 (长度为1)。
+// 参数: source - 需要归一化的源向量
+// 返回: 归一化后的向量；如果源向量为零向量，则返回零向量。
+inline sf::Vector2f normalize(const sf::Vector2f& source) {
+    float length = std::sqrt((source.x * source.x) + (source.y * source.y));
+    if (length != 0.f) { // 检查非零以避免除以零
+        return sf::Vector2f(source.x / length, source.y / length);
+    }
+    return sf::Vector2f(0.f, 0.f); // 如果是零向量，返回零向量
+}
+
+// =========================================================================
+// 子弹池配置与统计
+// =========================================================================
+enum class BulletPoolGrowth {
+    Fixed,  // 每次扩展 growthStep 个槽位
+    Double  // 每次容量翻倍
+};
+
+struct BulletPoolConfig {
+    size_t initialSize = 100;                     // 预分配槽位数
+    size_t maxSize = 2048;                        // 容量上限，达到后拒绝发射
+    BulletPoolGrowth growth = BulletPoolGrowth::Double;
+    size_t growthStep = 64;                       // Fixed 策略下每次扩展的槽位数
+};
+
+struct BulletPoolStats {
+    size_t highWaterMark = 0;   // 同时存活子弹数的峰值
+    size_t growthEvents = 0;    // 预分配之后发生的扩容次数
+    size_t rejectedSpawns = 0;  // 因达到容量上限而被拒绝的发射次数
+};
+
+// =========================================================================
+// BulletSystem: 结构数组 (SoA) 形式的子弹存储
+// =========================================================================
+// 每个字段一个连续数组。存活子弹始终紧凑地存放在 [0, getActiveCount()) 中，
+// update() 对这一段做连续的 SoA 循环 (可被编译器自动向量化)，碰撞与渲染也只遍历这一段。
+// 发射追加到末尾，kill() 把末尾子弹的数据搬到被回收的位置，两者都是 O(1)；
+// 因此下标只在两次 kill() 之间有效，子弹不应跨 tick 以下标引用。
+// 子弹不持有 sf::Sprite，渲染时才根据方向取图集子区域。
+class BulletSystem {
+public:
+
+    BulletSystem() = default;
+
+    // =========================================================================
+    // 容量与生命周期
+    // =========================================================================
+    void configure(const BulletPoolConfig& config); // 设置容量上限/扩容策略并预分配
+    void clear();                   // 所有子弹置为不活跃 (保留容量)
+    size_t capacity() const { return m_posX.size(); }
+
+    // 发射一颗子弹 (追加到紧凑区末尾)：容量不足时按策略扩容。
+    // 达到容量上限时返回 false
+    bool spawn(sf::Vector2f position, Direction direction, sf::Vector2f flyDirection,
+               int damage, float speed, int type);
+    // 回收下标为 index 的子弹：末尾子弹的数据被移到 index，
+    // 因此边遍历边回收时应从 getActiveCount() - 1 向前遍历
+    void kill(size_t index);
+
+    // =========================================================================
+    // 模拟
+    // =========================================================================
+    void update(sf::Time dt);       // 积分所有存活子弹的位置 (记录上一tick位置用于渲染插值)
+
+    // =========================================================================
+    // 存活数与统计
+    // =========================================================================
+    size_t getActiveCount() const { return m_activeCount; }
+    const BulletPoolStats& getStats() const { return m_stats; }
+    const BulletPoolConfig& getConfig() const { return m_config; }
+
+    // =========================================================================
+    // 按下标访问 (index < getActiveCount())
+    // =========================================================================
+    sf::Vector2f getPosition(size_t index) const { return sf::Vector2f(m_posX[index], m_posY[index]); }
+    sf::Vector2f getPreviousPosition(size_t index) const { return sf::Vector2f(m_prevX[index], m_prevY[index]); }
+    sf::Vector2f getInterpolatedPosition(size_t index, float alpha) const {
+        return sf::Vector2f(m_prevX[index] + (m_posX[index] - m_prevX[index]) * alpha,
+                            m_prevY[index] + (m_posY[index] - m_prevY[index]) * alpha);
+    }
+    sf::FloatRect getBounds(size_t index) const; // 以位置为中心、按方向取尺寸的碰撞盒
+    int getDamage(size_t index) const { return m_damage[index]; }
+    int getType(size_t index) const { return m_type[index]; }
+    Direction getDirection(size_t index) const { return static_cast<Direction>(m_direction[index]); }
+
+    // 各方向子弹的碰撞盒尺寸 (通常取自对应纹理；无界面模式下使用默认值)
+    void setHitboxSize(Direction direction, sf::Vector2f size);
+
+    static constexpr float DEFAULT_HITBOX_SIZE = 10.f; // 无纹理时的默认碰撞盒边长
+
+private:
+    // 位置与速度 (速度 = 飞行方向 * 速率，发射时算好)
+    std::vector<float> m_posX, m_posY;
+    std::vector<float> m_prevX, m_prevY;   // 上一tick的位置 (渲染插值)
+    std::vector<float> m_velX, m_velY;
+
+    // 逻辑属性
+    std::vector<int> m_damage;
+    std::vector<int> m_type;               // 子弹类型 (1: 玩家, 2: AI)
+    std::vector<std::uint8_t> m_direction; // Direction 枚举值
+    size_t m_activeCount = 0;              // 存活子弹数，数据位于 [0, m_activeCount)
+
+    BulletPoolConfig m_config;
+    BulletPoolStats m_stats;
+
+    sf::Vector2f m_hitboxSize[4] = {
+            {DEFAULT_HITBOX_SIZE, DEFAULT_HITBOX_SIZE}, {DEFAULT_HITBOX_SIZE, DEFAULT_HITBOX_SIZE},
+            {DEFAULT_HITBOX_SIZE, DEFAULT_HITBOX_SIZE}, {DEFAULT_HITBOX_SIZE, DEFAULT_HITBOX_SIZE}
+    };
+
+    bool grow();                   // 按策略扩容；已达上限时返回 false
+    void resizeTo(size_t newSize); // 扩展所有数组 (新槽位位于存活区之后)
+};
+
+#endif //TANKS_BULLETSYSTEM_H
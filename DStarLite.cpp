@@ -0,0 +1,233 @@
+// DStarLite.cpp
+#include "DStarLite.h"
+#include "FlowField.h" // 共用 FlowField::enterCost 代价规则
+#include "Map.h"
+#include <algorithm>
+#include <cstdlib>    // std::abs
+#include <functional> // std::greater
+
+namespace {
+const int NEIGHBOR_DX[4] = {0, 0, -1, 1};
+const int NEIGHBOR_DY[4] = {-1, 1, 0, 0};
+
+// km 只增不减，超过此值时干脆从零开始，避免键值溢出
+const std::uint32_t KM_RESET_LIMIT = 1u << 24;
+
+// 格子状态哈希表的初始容量 (避免搜索初期反复扩容)
+const size_t INITIAL_CELL_CAPACITY = 1024;
+
+std::uint32_t saturatingAdd(std::uint32_t a, std::uint32_t b) {
+    return (a > DStarLite::UNREACHABLE - b) ? DStarLite::UNREACHABLE : a + b;
+}
+}
+
+DStarLite::DStarLite()
+        : m_width(0), m_height(0), m_start(-1, -1), m_goal(-1, -1), m_km(0), m_map(nullptr),
+          m_mapGeneration(0), m_changeCursor(0),
+          m_resets(0), m_expansions(0) {
+}
+
+// =========================================================================
+// 查询
+// =========================================================================
+bool DStarLite::findPath(const Map& map, sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& path) {
+    path.clear();
+    if (start.x < 0 || start.y < 0 || start.x >= map.getMapWidth() || start.y >= map.getMapHeight() ||
+        goal.x < 0 || goal.y < 0 || goal.x >= map.getMapWidth() || goal.y >= map.getMapHeight()) {
+        return false;
+    }
+    if (start == goal) return false;
+
+    m_map = &map;
+    if (m_cells.empty() || map.getLayoutGeneration() != m_mapGeneration ||
+        map.getMapWidth() != m_width || map.getMapHeight() != m_height || m_km > KM_RESET_LIMIT) {
+        reset(map, start, goal);
+    } else {
+        syncMapChanges(map);
+        if (goal != m_goal) moveGoal(goal);
+        if (start != m_start) moveStart(start);
+    }
+    computeShortestPath();
+
+    const int startIndex = toIndex(m_start);
+    int current = toIndex(m_goal);
+    if (gValue(current) == UNREACHABLE) return false;
+
+    // 从目标沿 g 值最小的前驱回溯到根，再反转得到从 start 出发的路径
+    const size_t maxSteps = static_cast<size_t>(m_width) * m_height;
+    while (path.size() < maxSteps) {
+        const int x = current % m_width;
+        const int y = current / m_width;
+        path.emplace_back(x, y);
+        int bestIndex = -1;
+        std::uint32_t bestG = UNREACHABLE;
+        for (int n = 0; n < 4; ++n) {
+            sf::Vector2i neighbor(x + NEIGHBOR_DX[n], y + NEIGHBOR_DY[n]);
+            if (!inBounds(neighbor)) continue;
+            const int ni = toIndex(neighbor);
+            const std::uint32_t neighborG = gValue(ni);
+            if (neighborG < bestG) {
+                bestG = neighborG;
+                bestIndex = ni;
+            }
+        }
+        if (bestIndex < 0 || bestG >= gValue(current)) break; // 没有更近的前驱 (不应发生)
+        if (bestIndex == startIndex) {
+            std::reverse(path.begin(), path.end());
+            return true;
+        }
+        current = bestIndex;
+    }
+    path.clear();
+    return false;
+}
+
+// =========================================================================
+// 搜索状态维护
+// =========================================================================
+void DStarLite::reset(const Map& map, sf::Vector2i start, sf::Vector2i goal) {
+    m_width = map.getMapWidth();
+    m_height = map.getMapHeight();
+    m_start = start;
+    m_goal = goal;
+    m_km = 0;
+    m_mapGeneration = map.getLayoutGeneration();
+    m_changeCursor = map.getTileChangeLog().size();
+    ++m_resets;
+
+    m_cells.clear();
+    m_cells.reserve(INITIAL_CELL_CAPACITY);
+    m_heap.clear();
+
+    const int startIndex = toIndex(start);
+    m_cells[startIndex].rhs = 0;
+    pushOpen(startIndex, calculateKey(startIndex));
+}
+
+void DStarLite::syncMapChanges(const Map& map) {
+    const std::vector<sf::Vector2i>& changes = map.getTileChangeLog();
+    for (; m_changeCursor < changes.size(); ++m_changeCursor) {
+        // 进入代价只影响该格自身的 rhs；g 值随后变化时再传播给邻格 (代价升降都适用)。
+        // 代价直接从地图读取，未变化的格子重新计算一次 rhs 也不会改变结果
+        updateVertex(toIndex(changes[m_changeCursor]));
+    }
+}
+
+void DStarLite::moveGoal(sf::Vector2i goal) {
+    // 启发值以目标为终点：目标移动 d 格，任一格子的启发值最多变化 d，累加到 km 保持旧键仍为下界
+    m_km += static_cast<std::uint32_t>(std::abs(goal.x - m_goal.x) + std::abs(goal.y - m_goal.y));
+    m_goal = goal;
+}
+
+void DStarLite::moveStart(sf::Vector2i start) {
+    // 根移动：旧根不再是 rhs = 0 的源头，新根成为源头；两者各自重新计算，其余格子按需修复
+    const int oldStartIndex = toIndex(m_start);
+    m_start = start;
+    updateVertex(oldStartIndex);
+    updateVertex(toIndex(start));
+}
+
+DStarLite::Key DStarLite::calculateKey(int index) const {
+    auto it = m_cells.find(index);
+    if (it == m_cells.end()) return Key(UNREACHABLE, UNREACHABLE);
+    const std::uint32_t best = std::min(it->second.g, it->second.rhs);
+    if (best == UNREACHABLE) return Key(UNREACHABLE, UNREACHABLE);
+    return Key(saturatingAdd(saturatingAdd(best, heuristic(index)), m_km), best);
+}
+
+void DStarLite::updateVertex(int index) {
+    Cell& cell = m_cells[index];
+    const std::uint32_t cost = enterCost(index);
+    if (index == toIndex(m_start)) {
+        cell.rhs = 0;
+    } else if (cost == UNREACHABLE) {
+        cell.rhs = UNREACHABLE;
+    } else {
+        // rhs = min(前驱g) + 进入本格的代价 (进入代价只取决于本格，与从哪个邻格进入无关)
+        const int x = index % m_width;
+        const int y = index / m_width;
+        std::uint32_t bestG = UNREACHABLE;
+        for (int n = 0; n < 4; ++n) {
+            sf::Vector2i neighbor(x + NEIGHBOR_DX[n], y + NEIGHBOR_DY[n]);
+            if (!inBounds(neighbor)) continue;
+            bestG = std::min(bestG, gValue(toIndex(neighbor)));
+        }
+        cell.rhs = saturatingAdd(bestG, cost);
+    }
+
+    if (cell.g != cell.rhs) {
+        pushOpen(index, calculateKey(index));
+    } else {
+        cell.inOpen = false;
+    }
+}
+
+void DStarLite::pushOpen(int index, const Key& key) {
+    Cell& cell = m_cells[index];
+    cell.inOpen = true;
+    cell.openKey = key;
+    m_heap.emplace_back(key, index);
+    std::push_heap(m_heap.begin(), m_heap.end(), std::greater<>());
+}
+
+bool DStarLite::topKey(Key& key) {
+    while (!m_heap.empty()) {
+        const auto& top = m_heap.front();
+        const Cell& cell = m_cells[top.second];
+        if (cell.inOpen && cell.openKey == top.first) {
+            key = top.first;
+            return true;
+        }
+        std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<>());
+        m_heap.pop_back();
+    }
+    return false;
+}
+
+void DStarLite::computeShortestPath() {
+    const int goalIndex = toIndex(m_goal);
+    Key top;
+    Cell& goal = m_cells[goalIndex]; // 哈希表节点地址在插入其他格子后保持不变
+    while (topKey(top) && (top < calculateKey(goalIndex) || goal.rhs != goal.g)) {
+        const int u = m_heap.front().second;
+        std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<>());
+        m_heap.pop_back();
+        Cell& cell = m_cells[u];
+        cell.inOpen = false;
+        ++m_expansions;
+
+        const Key newKey = calculateKey(u);
+        if (top < newKey) {
+            pushOpen(u, newKey); // 键因 km 增大而过期：按新键放回
+            continue;
+        }
+
+        const int x = u % m_width;
+        const int y = u / m_width;
+        if (cell.g > cell.rhs) {
+            cell.g = cell.rhs;   // 过一致：确定 g 值
+        } else {
+            cell.g = UNREACHABLE; // 欠一致 (代价上升或根移走)：作废后与邻格一起重新计算
+            updateVertex(u);
+        }
+        for (int n = 0; n < 4; ++n) {
+            sf::Vector2i neighbor(x + NEIGHBOR_DX[n], y + NEIGHBOR_DY[n]);
+            if (inBounds(neighbor)) updateVertex(toIndex(neighbor));
+        }
+    }
+}
+
+std::uint32_t DStarLite::gValue(int index) const {
+    auto it = m_cells.find(index);
+    return it == m_cells.end() ? UNREACHABLE : it->second.g;
+}
+
+std::uint32_t DStarLite::enterCost(int index) const {
+    return FlowField::enterCost(*m_map, index % m_width, index / m_width);
+}
+
+std::uint32_t DStarLite::heuristic(int index) const {
+    const int x = index % m_width;
+    const int y = index / m_width;
+    return static_cast<std::uint32_t>(std::abs(x - m_goal.x) + std::abs(y - m_goal.y));
+}
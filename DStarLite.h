@@ -0,0 +1,89 @@
+#ifndef TANKS_DSTARLITE_H
+#define TANKS_DSTARLITE_H
+
+// =========================================================================
+// 必要的头文件包含
+// =========================================================================
+#include <SFML/Graphics.hpp> // sf::Vector2i
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class Map;
+
+// =========================================================================
+// DStarLite: 追击移动目标的增量寻路 (Moving Target D* Lite 的基础版本)
+// =========================================================================
+// 每个追击型AI持有一个实例。搜索以AI所在格为根、向目标 (玩家所在格) 展开，
+// 并在两次查询之间保留 g/rhs 值，只修复受影响的部分：
+//   - 地图瓦片变化 (读取 Map 的变更记录)：只重新计算变化格子的 rhs，再向外传播；
+//   - 目标移动：累加 km 修正启发值，已有的搜索结果全部保留；
+//   - AI自身移动一格：旧根与新根各重新计算一次 rhs，其余部分按需修复。
+// 只有新关卡 (地图布局代数变化) 或首次查询时才从零开始。
+// 代价规则与 FlowField 相同：砖墙可以打穿，进入代价随剩余血量增加。
+// 格子状态按需存放在哈希表中 (只有搜索触及的格子占内存)，大地图上每个实例的开销与搜索范围成正比。
+class DStarLite {
+public:
+    static constexpr std::uint32_t UNREACHABLE = std::numeric_limits<std::uint32_t>::max();
+
+    DStarLite();
+
+    // 查询从 start 到 goal 的路径 (不含 start，含 goal)；不可达或 start == goal 时返回 false。
+    // 路径中可能有砖墙 (需要先打穿)；最后一格是目标本身 (目标所在，应原地开火)
+    bool findPath(const Map& map, sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& path);
+
+    // 统计 (性能对比用)
+    size_t getResetCount() const { return m_resets; }          // 从零开始搜索的次数
+    size_t getExpansionCount() const { return m_expansions; }  // 累计展开的格子数
+
+private:
+    using Key = std::pair<std::uint32_t, std::uint32_t>;
+
+    struct Cell {
+        std::uint32_t g = UNREACHABLE;
+        std::uint32_t rhs = UNREACHABLE;
+        Key openKey = Key(UNREACHABLE, UNREACHABLE); // 格子在开放表中的当前键
+        bool inOpen = false;
+    };
+
+    void reset(const Map& map, sf::Vector2i start, sf::Vector2i goal);
+    void syncMapChanges(const Map& map); // 按地图变更记录更新进入代价
+    void moveStart(sf::Vector2i start);
+    void moveGoal(sf::Vector2i goal);
+
+    Key calculateKey(int index) const;
+    void updateVertex(int index);
+    void computeShortestPath();
+    bool topKey(Key& key);               // 弹出过期堆条目后返回当前最小键；开放表为空时返回 false
+    void pushOpen(int index, const Key& key);
+
+    std::uint32_t heuristic(int index) const; // 到目标的曼哈顿距离 (每步代价至少为1，可采纳)
+    std::uint32_t gValue(int index) const;    // 未触及的格子 g = UNREACHABLE
+    std::uint32_t enterCost(int index) const; // 直接读地图 (变化由 syncMapChanges 传播)
+    bool inBounds(sf::Vector2i tile) const { return tile.x >= 0 && tile.y >= 0 && tile.x < m_width && tile.y < m_height; }
+    int toIndex(sf::Vector2i tile) const { return tile.y * m_width + tile.x; }
+
+    int m_width;
+    int m_height;
+    sf::Vector2i m_start;
+    sf::Vector2i m_goal;
+    std::uint32_t m_km; // 目标累计移动带来的启发值修正
+    const Map* m_map;   // 当前查询使用的地图 (只在 findPath 期间有效)
+
+    // 搜索触及过的格子状态，键 = y * m_width + x
+    std::unordered_map<int, Cell> m_cells;
+
+    // 开放表：最小堆 (键, 格子下标)；更新键时直接压入新条目，旧条目在出堆时按 Cell::openKey 判定过期
+    std::vector<std::pair<Key, int>> m_heap;
+
+    // 已消费的地图变更位置
+    std::uint32_t m_mapGeneration;
+    size_t m_changeCursor;
+
+    size_t m_resets;
+    size_t m_expansions;
+};
+
+#endif //TANKS_DSTARLITE_H
@@ -0,0 +1,167 @@
+// FlowField.cpp
+#include "FlowField.h"
+#include "Map.h"
+#include <algorithm>
+#include <functional> // std::greater
+
+namespace {
+const int NEIGHBOR_DX[4] = {0, 0, -1, 1};
+const int NEIGHBOR_DY[4] = {-1, 1, 0, 0};
+const Direction NEIGHBOR_DIR[4] = {Direction::UP, Direction::DOWN, Direction::LEFT, Direction::RIGHT};
+}
+
+FlowField::FlowField()
+        : m_width(0), m_height(0), m_goal(-1, -1),
+          m_mapGeneration(0), m_changeCursor(0),
+          m_fullRebuilds(0), m_incrementalUpdates(0) {
+}
+
+// =========================================================================
+// 构建与增量更新
+// =========================================================================
+void FlowField::build(const Map& map, sf::Vector2i goal) {
+    m_width = map.getMapWidth();
+    m_height = map.getMapHeight();
+    m_goal = goal;
+    m_mapGeneration = map.getLayoutGeneration();
+    m_changeCursor = map.getTileChangeLog().size();
+    ++m_fullRebuilds;
+
+    const size_t count = static_cast<size_t>(m_width) * m_height;
+    m_distance.assign(count, UNREACHABLE);
+    m_cost.assign(count, UNREACHABLE);
+    for (int y = 0; y < m_height; ++y) {
+        for (int x = 0; x < m_width; ++x) {
+            m_cost[y * m_width + x] = enterCost(map, x, y);
+        }
+    }
+
+    if (goal.x < 0 || goal.y < 0 || goal.x >= m_width || goal.y >= m_height) {
+        return;
+    }
+    m_heap.clear();
+    m_distance[goal.y * m_width + goal.x] = 0;
+    m_heap.emplace_back(0, goal.y * m_width + goal.x);
+    relax();
+}
+
+void FlowField::update(const Map& map) {
+    if (m_distance.empty()) return;
+    if (map.getLayoutGeneration() != m_mapGeneration ||
+        map.getMapWidth() != m_width || map.getMapHeight() != m_height) {
+        build(map, m_goal);
+        return;
+    }
+
+    const std::vector<sf::Vector2i>& changes = map.getTileChangeLog();
+    if (m_changeCursor >= changes.size()) return;
+
+    m_heap.clear();
+    for (; m_changeCursor < changes.size(); ++m_changeCursor) {
+        const sf::Vector2i& tile = changes[m_changeCursor];
+        const int index = tile.y * m_width + tile.x;
+        const std::uint32_t newCost = enterCost(map, tile.x, tile.y);
+        if (newCost == m_cost[index]) continue;
+        if (newCost > m_cost[index]) {
+            // 代价上升 (目前的规则下不会发生) 会让已有距离失效，直接整图重算
+            build(map, m_goal);
+            return;
+        }
+        m_cost[index] = newCost;
+        // 该格子变便宜后，经由它的邻格可能得到更短的距离：以它为种子重新松弛
+        if (m_distance[index] != UNREACHABLE) {
+            m_heap.emplace_back(m_distance[index], index);
+        } else {
+            // 之前不可经过的格子：先从邻格取得自身距离
+            std::uint32_t best = UNREACHABLE;
+            for (int n = 0; n < 4; ++n) {
+                int nx = tile.x + NEIGHBOR_DX[n];
+                int ny = tile.y + NEIGHBOR_DY[n];
+                if (nx < 0 || ny < 0 || nx >= m_width || ny >= m_height) continue;
+                int ni = ny * m_width + nx;
+                if (m_distance[ni] == UNREACHABLE) continue;
+                std::uint32_t through = (ni == m_goal.y * m_width + m_goal.x) ? 1 : m_cost[ni];
+                best = std::min(best, m_distance[ni] + through);
+            }
+            if (best != UNREACHABLE) {
+                m_distance[index] = best;
+                m_heap.emplace_back(best, index);
+            }
+        }
+    }
+    if (m_heap.empty()) return;
+
+    ++m_incrementalUpdates;
+    relax();
+}
+
+void FlowField::relax() {
+    const int goalIndex = m_goal.y * m_width + m_goal.x;
+    std::make_heap(m_heap.begin(), m_heap.end(), std::greater<>());
+    while (!m_heap.empty()) {
+        std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<>());
+        auto [dist, index] = m_heap.back();
+        m_heap.pop_back();
+        if (dist != m_distance[index]) continue; // 过期条目
+
+        // 从邻格走进当前格子需要付出当前格子的进入代价 (走进目标本身记为1)
+        const std::uint32_t through = (index == goalIndex) ? 1 : m_cost[index];
+        const int x = index % m_width;
+        const int y = index / m_width;
+        for (int n = 0; n < 4; ++n) {
+            int nx = x + NEIGHBOR_DX[n];
+            int ny = y + NEIGHBOR_DY[n];
+            if (nx < 0 || ny < 0 || nx >= m_width || ny >= m_height) continue;
+            int ni = ny * m_width + nx;
+            if (m_cost[ni] == UNREACHABLE) continue; // 坦克无法停留的格子不参与
+            std::uint32_t candidate = dist + through;
+            if (candidate < m_distance[ni]) {
+                m_distance[ni] = candidate;
+                m_heap.emplace_back(candidate, ni);
+                std::push_heap(m_heap.begin(), m_heap.end(), std::greater<>());
+            }
+        }
+    }
+}
+
+std::uint32_t FlowField::enterCost(const Map& map, int tileX, int tileY) {
+    int tileType = map.getTileType(tileX, tileY);
+    if (tileType == 0 || tileType == 5) return 1;  // 草地/森林
+    if (tileType == 1) {                           // 砖墙：需要先打穿
+        return 1 + BRICK_HIT_COST * static_cast<std::uint32_t>(std::max(0, map.getTileHealth(tileX, tileY)));
+    }
+    return UNREACHABLE;                            // 钢墙/水/基地/越界
+}
+
+// =========================================================================
+// 查询
+// =========================================================================
+std::uint32_t FlowField::getDistance(sf::Vector2i tile) const {
+    if (tile.x < 0 || tile.y < 0 || tile.x >= m_width || tile.y >= m_height) return UNREACHABLE;
+    return m_distance[tile.y * m_width + tile.x];
+}
+
+bool FlowField::getNextStep(sf::Vector2i tile, Direction& direction, sf::Vector2i& nextTile) const {
+    const std::uint32_t here = getDistance(tile);
+    if (here == UNREACHABLE || here == 0) return false;
+
+    // 选择使 (邻格距离 + 进入邻格的代价) 最小的邻格，即 Dijkstra 中给出当前距离的那一步
+    const int goalIndex = m_goal.y * m_width + m_goal.x;
+    std::uint32_t best = UNREACHABLE;
+    for (int n = 0; n < 4; ++n) {
+        int nx = tile.x + NEIGHBOR_DX[n];
+        int ny = tile.y + NEIGHBOR_DY[n];
+        if (nx < 0 || ny < 0 || nx >= m_width || ny >= m_height) continue;
+        int ni = ny * m_width + nx;
+        if (m_distance[ni] == UNREACHABLE) continue;
+        std::uint32_t through = (ni == goalIndex) ? 1 : m_cost[ni];
+        if (through == UNREACHABLE) continue;
+        std::uint32_t total = m_distance[ni] + through;
+        if (total < best) {
+            best = total;
+            direction = NEIGHBOR_DIR[n];
+            nextTile = sf::Vector2i(nx, ny);
+        }
+    }
+    return best != UNREACHABLE;
+}
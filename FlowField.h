@@ -0,0 +1,69 @@
+#ifndef TANKS_FLOWFIELD_H
+#define TANKS_FLOWFIELD_H
+
+// =========================================================================
+// 必要的头文件包含
+// =========================================================================
+#include <SFML/Graphics.hpp> // sf::Vector2i
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "common.h"          // Direction 枚举
+
+class Map;
+
+// =========================================================================
+// FlowField: 以单个目标格 (基地) 为源的共享距离场
+// =========================================================================
+// 对全图做一次反向 Dijkstra，记录每个格子到目标的代价；AI 只需比较4个邻格就能得到下一步 (O(1))。
+// 可通行格子 (草地/森林) 进入代价为1；砖墙可被打穿，进入代价随剩余血量增加；
+// 钢墙、水和地图外不可经过。
+// update() 读取 Map 的瓦片变更记录：砖墙受损或被摧毁只会降低代价，
+// 因此只从变化的格子向外做“只减不增”的松弛，不必整图重算。
+class FlowField {
+public:
+    static constexpr std::uint32_t UNREACHABLE = std::numeric_limits<std::uint32_t>::max();
+
+    FlowField();
+
+    void build(const Map& map, sf::Vector2i goal); // 整图重算 (新关卡、目标变化时)
+    void update(const Map& map);                   // 按地图变更记录增量更新 (每tick调用，无变化时几乎无开销)
+
+    // 查询从 tile 出发的下一步方向；不可达或已在目标旁时返回 false。
+    // nextTile 为要进入的格子 (可能是砖墙，需要先打穿；也可能是目标本身)
+    bool getNextStep(sf::Vector2i tile, Direction& direction, sf::Vector2i& nextTile) const;
+
+    std::uint32_t getDistance(sf::Vector2i tile) const;
+    sf::Vector2i getGoal() const { return m_goal; }
+    bool isValid() const { return !m_distance.empty(); }
+
+    // 统计 (性能对比用)
+    size_t getFullRebuildCount() const { return m_fullRebuilds; }
+    size_t getIncrementalUpdateCount() const { return m_incrementalUpdates; }
+
+    static constexpr std::uint32_t BRICK_HIT_COST = 2; // 砖墙每点血量额外的代价 (约等于开火等待)
+
+    // 坦克进入格子的代价 (UNREACHABLE: 不可经过)，追击玩家的寻路 (DStarLite) 也使用同一套规则
+    static std::uint32_t enterCost(const Map& map, int tileX, int tileY);
+
+private:
+    void relax();                // 从 m_heap 中的种子开始做 Dijkstra 松弛
+
+    int m_width;
+    int m_height;
+    sf::Vector2i m_goal;
+    std::vector<std::uint32_t> m_distance; // 行优先，下标 = y * m_width + x
+    std::vector<std::uint32_t> m_cost;     // 构建时记录的进入代价，用于判断变化方向
+
+    // Dijkstra 堆 (距离, 格子下标)，作为成员复用以避免每次分配
+    std::vector<std::pair<std::uint32_t, int>> m_heap;
+
+    // 已消费的地图变更位置
+    std::uint32_t m_mapGeneration;
+    size_t m_changeCursor;
+
+    size_t m_fullRebuilds;
+    size_t m_incrementalUpdates;
+};
+
+#endif //TANKS_FLOWFIELD_H
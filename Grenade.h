@@ -6,14 +6,14 @@
 #define TANKS_GRENADE_H
 
 #include "Tools.h"
-#include "game.h"
+#include "World.h"
 
 class GrenadeTool:public Tools
 {
 public:
-    GrenadeTool(sf::Vector2f pos,const sf::Texture &texture);
+    GrenadeTool(sf::Vector2f pos,const TextureRegion &texture);
 
-    void applyEffect(Tank& tank,Game& gameContext) override;
+    void applyEffect(Tank& tank,World& worldContext) override;
 
 };
 
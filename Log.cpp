@@ -0,0 +1,117 @@
+// Log.cpp
+#include "Log.h"
+#include <algorithm> // std::min
+#include <chrono>
+#include <cstring>   // std::memcpy
+#include <iostream>
+
+Logger& Logger::instance() {
+    static Logger logger; // 首次使用时启动写线程，程序退出时析构并写完剩余消息
+    return logger;
+}
+
+Logger::Logger() : m_slots(new Slot[CAPACITY]) {
+    for (size_t i = 0; i < CAPACITY; ++i) m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    m_writer = std::thread(&Logger::writerLoop, this);
+}
+
+Logger::~Logger() {
+    shutdown();
+}
+
+std::ostringstream& Logger::threadStream() {
+    thread_local std::ostringstream stream;
+    stream.str(std::string());
+    stream.clear();
+    stream.flags(std::ios_base::dec | std::ios_base::skipws); // 清掉上一条留下的 std::fixed 等格式
+    stream.precision(6);
+    stream.width(0);
+    stream.fill(' ');
+    return stream;
+}
+
+// =========================================================================
+// 生产者
+// =========================================================================
+void Logger::write(LogLevel level, const std::string& message) {
+    if (!m_running.load(std::memory_order_acquire)) { // 已关闭：直接同步输出
+        (level >= LogLevel::Warn ? std::cerr : std::cout) << message << '\n';
+        return;
+    }
+    if (!tryPush(level, message)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool Logger::tryPush(LogLevel level, const std::string& message) {
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    for (;;) {
+        slot = &m_slots[pos & (CAPACITY - 1)];
+        const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break; // 抢到该槽位
+        } else if (diff < 0) {
+            return false; // 缓冲已满 (写线程还没取走一整圈之前的消息)
+        } else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed); // 被其他生产者抢先，重试
+        }
+    }
+    const size_t length = std::min(message.size(), MAX_MESSAGE_BYTES);
+    std::memcpy(slot->text, message.data(), length);
+    slot->length = static_cast<std::uint16_t>(length);
+    slot->level = level;
+    slot->sequence.store(pos + 1, std::memory_order_release); // 发布给写线程
+    return true;
+}
+
+// =========================================================================
+// 写线程
+// =========================================================================
+size_t Logger::drain() {
+    size_t count = 0;
+    bool wroteError = false;
+    for (;;) {
+        Slot& slot = m_slots[m_dequeuePos & (CAPACITY - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1) break; // 没有更多已发布的消息
+        std::ostream& out = slot.level >= LogLevel::Warn ? std::cerr : std::cout;
+        out.write(slot.text, slot.length);
+        out.put('\n');
+        wroteError = wroteError || slot.level >= LogLevel::Warn;
+        slot.sequence.store(m_dequeuePos + CAPACITY, std::memory_order_release); // 槽位交还给下一圈的生产者
+        ++m_dequeuePos;
+        ++count;
+    }
+    const std::uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != m_reportedDropped) {
+        std::cerr << "[log] " << dropped - m_reportedDropped << " message(s) dropped (ring buffer full)" << '\n';
+        m_reportedDropped = dropped;
+        wroteError = true;
+    }
+    if (count > 0) {
+        std::cout.flush(); // 每批只刷新一次
+        if (wroteError) std::cerr.flush();
+        m_written.fetch_add(count, std::memory_order_release);
+    }
+    return count;
+}
+
+void Logger::writerLoop() {
+    while (m_running.load(std::memory_order_acquire)) {
+        if (drain() == 0) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    drain(); // 关闭前写完剩余消息
+}
+
+void Logger::flush() {
+    const size_t target = m_enqueuePos.load(std::memory_order_acquire);
+    while (m_running.load(std::memory_order_acquire) && m_written.load(std::memory_order_acquire) < target) {
+        std::this_thread::yield();
+    }
+}
+
+void Logger::shutdown() {
+    if (!m_running.exchange(false, std::memory_order_acq_rel)) return;
+    if (m_writer.joinable()) m_writer.join();
+}
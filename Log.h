@@ -0,0 +1,129 @@
+#ifndef TANKS_LOG_H
+#define TANKS_LOG_H
+
+// =========================================================================
+// 必要的头文件包含
+// =========================================================================
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// =========================================================================
+// 日志级别与编译期阈值
+// =========================================================================
+// 低于 TANKS_LOG_LEVEL 的日志宏展开为空语句，参数表达式完全不参与编译
+// (CMake 选项 TANKS_LOG_LEVEL=DEBUG/INFO/WARN/ERROR/OFF，默认 INFO：每次射击/命中等调试日志不进入发布版本)。
+#define TANKS_LOG_LEVEL_DEBUG 0
+#define TANKS_LOG_LEVEL_INFO  1
+#define TANKS_LOG_LEVEL_WARN  2
+#define TANKS_LOG_LEVEL_ERROR 3
+#define TANKS_LOG_LEVEL_OFF   4
+
+#ifndef TANKS_LOG_LEVEL
+#define TANKS_LOG_LEVEL TANKS_LOG_LEVEL_INFO
+#endif
+
+enum class LogLevel : std::uint8_t {
+    Debug = TANKS_LOG_LEVEL_DEBUG,
+    Info = TANKS_LOG_LEVEL_INFO,
+    Warn = TANKS_LOG_LEVEL_WARN,
+    Error = TANKS_LOG_LEVEL_ERROR,
+    Off = TANKS_LOG_LEVEL_OFF
+};
+
+// =========================================================================
+// Logger: 无锁环形缓冲 + 后台写线程
+// =========================================================================
+// 调用线程只把格式化好的一行文本拷进环形缓冲的槽位 (多生产者、单消费者，无锁)，
+// 真正的控制台输出由后台线程批量完成 (Warn/Error 写 std::cerr，其余写 std::cout)，
+// 游戏线程不再因为 std::endl 的同步刷新而阻塞。缓冲满时丢弃新消息并计数，绝不阻塞调用方。
+class Logger {
+public:
+    static constexpr size_t CAPACITY = 4096;         // 槽位数 (2 的幂)
+    static constexpr size_t MAX_MESSAGE_BYTES = 256; // 单条消息上限，超出部分截断
+
+    static Logger& instance();
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    // 运行期过滤 (只能在编译期阈值之上进一步收紧，例如无界面批量运行只保留警告与错误)
+    void setLevel(LogLevel level) { m_level.store(static_cast<std::uint8_t>(level), std::memory_order_relaxed); }
+    bool isEnabled(LogLevel level) const { return static_cast<std::uint8_t>(level) >= m_level.load(std::memory_order_relaxed); }
+
+    void write(LogLevel level, const std::string& message);
+    void flush();    // 等待已提交的消息全部写出 (例如在直接打印报告之前)
+    void shutdown(); // 写完剩余消息并结束后台线程；之后的消息同步输出
+
+    std::uint64_t getDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    // 每个线程复用一个格式化流 (每次使用前恢复默认格式)，避免每条日志都构造 ostringstream
+    static std::ostringstream& threadStream();
+
+private:
+    Logger();
+    bool tryPush(LogLevel level, const std::string& message);
+    size_t drain();  // 写线程：取出并输出所有可用消息，返回条数
+    void writerLoop();
+
+    struct Slot {
+        std::atomic<size_t> sequence{0}; // 槽位状态 (Vyukov 有界队列)：等于写入位置时可写，等于写入位置+1时可读
+        LogLevel level = LogLevel::Info;
+        std::uint16_t length = 0;
+        char text[MAX_MESSAGE_BYTES];
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    alignas(64) std::atomic<size_t> m_enqueuePos{0};
+    alignas(64) size_t m_dequeuePos = 0;          // 只由写线程访问
+    std::atomic<size_t> m_written{0};             // 已输出的条数 (flush 等待用)
+    std::atomic<std::uint64_t> m_dropped{0};
+    std::uint64_t m_reportedDropped = 0;          // 只由写线程访问
+    std::atomic<std::uint8_t> m_level{static_cast<std::uint8_t>(LogLevel::Debug)};
+    std::atomic<bool> m_running{true};
+    std::thread m_writer;
+};
+
+// =========================================================================
+// 日志宏：LOG_INFO("Map size: " << w << "x" << h);  (不需要 std::endl)
+// =========================================================================
+#define TANKS_LOG_AT(level, message)                                          \
+    do {                                                                      \
+        if (Logger::instance().isEnabled(level)) {                            \
+            std::ostringstream& tanksLogStream = Logger::threadStream();      \
+            tanksLogStream << message;                                        \
+            Logger::instance().write(level, tanksLogStream.str());            \
+        }                                                                     \
+    } while (0)
+
+#define TANKS_LOG_DISABLED() do {} while (0)
+
+#if TANKS_LOG_LEVEL <= TANKS_LOG_LEVEL_DEBUG
+#define LOG_DEBUG(message) TANKS_LOG_AT(LogLevel::Debug, message)
+#else
+#define LOG_DEBUG(message) TANKS_LOG_DISABLED()
+#endif
+
+#if TANKS_LOG_LEVEL <= TANKS_LOG_LEVEL_INFO
+#define LOG_INFO(message) TANKS_LOG_AT(LogLevel::Info, message)
+#else
+#define LOG_INFO(message) TANKS_LOG_DISABLED()
+#endif
+
+#if TANKS_LOG_LEVEL <= TANKS_LOG_LEVEL_WARN
+#define LOG_WARN(message) TANKS_LOG_AT(LogLevel::Warn, message)
+#else
+#define LOG_WARN(message) TANKS_LOG_DISABLED()
+#endif
+
+#if TANKS_LOG_LEVEL <= TANKS_LOG_LEVEL_ERROR
+#define LOG_ERROR(message) TANKS_LOG_AT(LogLevel::Error, message)
+#else
+#define LOG_ERROR(message) TANKS_LOG_DISABLED()
+#endif
+
+#endif //TANKS_LOG_H
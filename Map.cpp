@@ -1,15 +1,23 @@
 // Map.cpp
 #include "Map.h"
-#include "Game.h" // 包含 Game.h 以便使用 Game& game 或 Game* game
+#include "World.h"           // 包含 World.h 以便使用 World& world
+#include "ResourceManager.h" // 地图瓦片纹理来源
 #include <iostream>
 #include <vector>       // 确保包含
 #include <algorithm>    // For std::fill, std::shuffle, std::min, std::max
 #include <random>       // For std::mt19937, std::uniform_int_distribution
+#include <cmath>        // For std::floor, std::abs
+#include <limits>       // For std::numeric_limits
 
 // =========================================================================
 // 构造函数
 // =========================================================================
-Map::Map() : m_tileWidth(0), m_tileHeight(0),
+Map::Map() : m_grid(&Map::isWalkableTile),
+             m_tileAtlas(nullptr),
+             m_hasTileAtlas(false),
+             m_meshGeneration(0), m_meshChangeCursor(0),
+             m_layoutGeneration(0),
+             m_tileWidth(0), m_tileHeight(0),
              m_mapWidth(24), m_mapHeight(15), // 默认地图尺寸 (格子数)
              m_baseHealth(BASE_INITIAL_HEALTH),
              m_isBaseDestroyed(false) {
@@ -19,87 +27,114 @@ Map::Map() : m_tileWidth(0), m_tileHeight(0),
 // =========================================================================
 // 初始化与加载方法
 // =========================================================================
-bool Map::loadDimensionsAndTextures(Game& game) {
-    // 从 Game 对象获取图块尺寸信息 (基于一个标准瓦片，如草地)
-    const sf::Texture& sampleTexture = game.getTexture("map_grass"); // 假设 "map_grass" 是草地瓦片的键
+bool Map::loadDimensionsAndTextures(const ResourceManager* resources) {
+    if (!resources) {
+        // 无界面模式：没有纹理可供参考，直接使用默认瓦片尺寸
+        // 地图尺寸保持构造时的默认值 (或 setMapSize 设定的值)
+        m_tileWidth = 50;
+        m_tileHeight = 50;
+        return true;
+    }
+
+    // 从 ResourceManager 获取图块尺寸信息 (基于一个标准瓦片，如草地)
+    const TextureRegion& sampleTexture = resources->getTexture("map_grass"); // 假设 "map_grass" 是草地瓦片的键
 
     if (sampleTexture.getSize().x == 0 || sampleTexture.getSize().y == 0) {
-        std::cerr << "Map::loadDimensionsAndTextures() - Error: Could not get valid sample texture ('map_grass') from Game object to determine tile size." << std::endl;
+        LOG_ERROR("Map::loadDimensionsAndTextures() - Error: Could not get valid sample texture ('map_grass') from ResourceManager to determine tile size.");
         // 设置一个默认的回退值
         m_tileWidth = 50;
         m_tileHeight = 50;
-        std::cerr << "Map::loadDimensionsAndTextures() - Using default tile size: " << m_tileWidth << "x" << m_tileHeight << std::endl;
+        LOG_WARN("Map::loadDimensionsAndTextures() - Using default tile size: " << m_tileWidth << "x" << m_tileHeight);
         // return false; // 如果无法确定图块尺寸则加载失败
     } else {
         m_tileWidth = sampleTexture.getSize().x;
         m_tileHeight = sampleTexture.getSize().y;
     }
 
-    // 实际地图的格子数，可以固定或从配置读取
-    // 游戏区域宽度 1200px / 瓦片宽度 (例如 50px) = 24 tiles
-    // 窗口高度 750px / 瓦片高度 (例如 50px) = 15 tiles
-    if (m_tileWidth > 0) m_mapWidth = 1200 / m_tileWidth; else m_mapWidth = 24;
-    if (m_tileHeight > 0) m_mapHeight = 750 / m_tileHeight; else m_mapHeight = 15;
-
+    // 地图格子数与瓦片像素尺寸无关：默认 24x15，可由 config.json 的 "map" 通过 setMapSize 覆盖
+    LOG_INFO("Map dimensions set: " << m_mapWidth << "x" << m_mapHeight
+              << " tiles. Tile size: " << m_tileWidth << "x" << m_tileHeight);
 
-    std::cout << "Map dimensions set: " << m_mapWidth << "x" << m_mapHeight
-              << " tiles. Tile size: " << m_tileWidth << "x" << m_tileHeight << std::endl;
-
-    // (可选) 验证所有必需的地图纹理是否已在 Game 中加载
-    // Game::getTexture() 在找不到纹理时应该已经有错误处理。
+    // (可选) 验证所有必需的地图纹理是否已在 ResourceManager 中加载
+    // ResourceManager::getTexture() 在找不到纹理时应该已经有错误处理。
     // 例如:
-    if (game.getTexture("map_brick_wall").getSize().x == 0) {
-        std::cerr << "Map::loadDimensionsAndTextures() - Warning: Brick wall texture ('map_brick_wall') seems to be missing or invalid." << std::endl;
+    if (resources->getTexture("map_brick_wall").getSize().x == 0) {
+        LOG_WARN("Map::loadDimensionsAndTextures() - Warning: Brick wall texture ('map_brick_wall') seems to be missing or invalid.");
     }
-    if (game.getTexture("map_water").getSize().x == 0) {
-        std::cerr << "Map::loadDimensionsAndTextures() - Warning: Water texture ('map_water') seems to be missing or invalid." << std::endl;
+    if (resources->getTexture("map_water").getSize().x == 0) {
+        LOG_WARN("Map::loadDimensionsAndTextures() - Warning: Water texture ('map_water') seems to be missing or invalid.");
     }
-    if (game.getTexture("map_forest").getSize().x == 0) {
-        std::cerr << "Map::loadDimensionsAndTextures() - Warning: Forest texture ('map_forest') seems to be missing or invalid." << std::endl;
+    if (resources->getTexture("map_forest").getSize().x == 0) {
+        LOG_WARN("Map::loadDimensionsAndTextures() - Warning: Forest texture ('map_forest') seems to be missing or invalid.");
     }
 
+    // 取得所有地图瓦片在图集中的位置，之后每个块可以一次绘制
+    bindTileAtlas(*resources);
+
 
     return true; // 所有加载步骤完成
 }
 
+void Map::setMapSize(int widthTiles, int heightTiles) {
+    // 至少 3x3：边界钢墙 + 一格内部
+    m_mapWidth = std::max(3, widthTiles);
+    m_mapHeight = std::max(3, heightTiles);
+    LOG_INFO("Map size set: " << m_mapWidth << "x" << m_mapHeight << " tiles ("
+              << TileChunkGrid::CHUNK_SIZE << "x" << TileChunkGrid::CHUNK_SIZE << " chunks).");
+}
+
 void Map::initializeTileHealth() {
-    if (m_layout.empty()) {
+    if (m_grid.isEmpty()) {
         // std::cerr << "Map::initializeTileHealth() - Warning: Layout is empty. Cannot initialize tile health." << std::endl;
         return;
     }
-    // 确保 m_tileHealth 与 m_layout 尺寸一致
-    m_tileHealth.assign(m_mapHeight, std::vector<int>(m_mapWidth, 0));
 
-    for (int y = 0; y < m_mapHeight; ++y) {
-        for (int x = 0; x < m_mapWidth; ++x) {
-            if (m_layout[y][x] == 1) { // 砖墙 (ID 1)
-                m_tileHealth[y][x] = BRICK_INITIAL_HEALTH;
-            }
-            // 其他类型的瓦片目前没有独立的生命值系统（除了基地）
-        }
-    }
+    // 只有砖墙 (ID 1) 有独立的血量；其他类型的瓦片目前没有生命值系统（除了基地）
+    // 按块批量处理 (紧凑块只改调色板，未分配的块只改填充值)
+    m_grid.transformAll([](std::uint8_t tile) {
+        int tileType = unpackType(tile);
+        return packTile(tileType, tileType == 1 ? BRICK_INITIAL_HEALTH : 0);
+    });
+
+    // 整张布局已重建：通知所有使用者全量刷新
+    ++m_layoutGeneration;
+    m_tileChangeLog.clear();
+}
+
+void Map::markTileChanged(int tileX, int tileY) {
+    m_tileChangeLog.emplace_back(tileX, tileY);
+}
+
+void Map::resizeGrid() {
+    m_grid.reset(m_mapWidth, m_mapHeight, packTile(0, 0)); // 全部置为草地 (ID 0)，块在首次写入时分配
+    m_chunkMeshes.clear();
+    m_chunkMeshes.resize(m_grid.getChunkCount());
+    m_chunkMeshBuilt.assign(m_grid.getChunkCount(), 0);
+}
+
+void Map::setTileType(int tileX, int tileY, int tileType) {
+    m_grid.set(tileX, tileY, packTile(tileType, unpackHealth(m_grid.get(tileX, tileY)))); // 可通行位由网格同步
 }
 
-void Map::generateLayout(int level, std::mt19937& rng, const Game& game) {
-    std::cout << "Generating layout for Level " << level << std::endl;
+void Map::generateLayout(int level, std::mt19937& rng, const World& world) {
+    TRACE_SCOPE("Map::generateLayout");
+    LOG_INFO("Generating layout for Level " << level);
 
     // 确保地图尺寸已设置
     if (m_mapWidth <= 0 || m_mapHeight <= 0) {
-        std::cerr << "Map::generateLayout() Error: Map dimensions are not set or invalid (W:" << m_mapWidth << ", H:" << m_mapHeight << ")." << std::endl;
-        // 尝试从game对象获取一次，如果之前失败了
-        // const_cast<Game&>(game).getMap().loadDimensionsAndTextures(const_cast<Game&>(game)); // 不太好的做法
-        // 更好的做法是在Game::setupLevel之前确保loadDimensionsAndTextures已成功
+        LOG_ERROR("Map::generateLayout() Error: Map dimensions are not set or invalid (W:" << m_mapWidth << ", H:" << m_mapHeight << ").");
+        // 应在 World::setupLevel 之前 (World::init 中) 确保 loadDimensionsAndTextures 已成功
         if (m_mapWidth <=0 || m_mapHeight <=0) return; // 如果仍然无效，则无法生成
     }
 
 
-    m_layout.assign(m_mapHeight, std::vector<int>(m_mapWidth, 0)); // 全部置为草地 (ID 0)
+    resizeGrid(); // 全部置为草地 (ID 0)
 
     // 1. 绘制边界 (钢墙 ID 2)
     for (int y = 0; y < m_mapHeight; ++y) {
         for (int x = 0; x < m_mapWidth; ++x) {
             if (y == 0 || y == m_mapHeight - 1 || x == 0 || x == m_mapWidth - 1) {
-                m_layout[y][x] = 2; // 钢墙
+                setTileType(x, y, 2); // 钢墙
             }
         }
     }
@@ -109,21 +144,21 @@ void Map::generateLayout(int level, std::mt19937& rng, const Game& game) {
     if (basePos.x != -1 && basePos.y != -1 &&
         basePos.x < m_mapWidth && basePos.y < m_mapHeight &&
         basePos.x >= 0 && basePos.y >=0 ) { // 额外边界检查
-        m_layout[basePos.y][basePos.x] = 3; // 基地核心
+        setTileType(basePos.x, basePos.y, 3); // 基地核心
 
         // 周围一圈砖墙 (ID 1) - 确保不越界
         int bx = basePos.x;
         int by = basePos.y;
-        if (by - 1 >= 0) m_layout[by - 1][bx] = 1;
-        if (by - 1 >= 0 && bx - 1 >= 0) m_layout[by - 1][bx - 1] = 1;
-        if (by - 1 >= 0 && bx + 1 < m_mapWidth) m_layout[by - 1][bx + 1] = 1;
-        if (bx - 1 >= 0) m_layout[by][bx - 1] = 1;
-        if (bx + 1 < m_mapWidth) m_layout[by][bx + 1] = 1;
+        if (by - 1 >= 0) setTileType(bx, by - 1, 1);
+        if (by - 1 >= 0 && bx - 1 >= 0) setTileType(bx - 1, by - 1, 1);
+        if (by - 1 >= 0 && bx + 1 < m_mapWidth) setTileType(bx + 1, by - 1, 1);
+        if (bx - 1 >= 0) setTileType(bx - 1, by, 1);
+        if (bx + 1 < m_mapWidth) setTileType(bx + 1, by, 1);
     } else {
-        std::cerr << "Error: Could not determine valid base position for map generation! BasePos: (" << basePos.x << "," << basePos.y << ")" << std::endl;
+        LOG_ERROR("Error: Could not determine valid base position for map generation! BasePos: (" << basePos.x << "," << basePos.y << ")");
         // 放置一个绝对安全的默认位置的基地以防万一
         if (m_mapHeight > 1 && m_mapWidth > 2) {
-            m_layout[m_mapHeight-1][m_mapWidth/2] = 3;
+            setTileType(m_mapWidth/2, m_mapHeight-1, 3);
         }
     }
 
@@ -132,22 +167,22 @@ void Map::generateLayout(int level, std::mt19937& rng, const Game& game) {
 
     for (int y = 1; y < m_mapHeight - 1; ++y) { // 不在边界上生成
         for (int x = 1; x < m_mapWidth - 1; ++x) {
-            if (m_layout[y][x] != 0) continue; // 如果已被基地或其保护占据，或已是边界，则跳过
+            if (tileTypeAt(x, y) != 0) continue; // 如果已被基地或其保护占据，或已是边界，则跳过
 
             int randomValue = distribTileType(rng);
 
             if (level == 1) {
-                if (randomValue < 25) m_layout[y][x] = 1; // 25% 砖墙
-                else if (randomValue < 30) m_layout[y][x] = 2; // 5% 钢墙
+                if (randomValue < 25) setTileType(x, y, 1); // 25% 砖墙
+                else if (randomValue < 30) setTileType(x, y, 2); // 5% 钢墙
             } else if (level == 2) {
-                if (randomValue < 20) m_layout[y][x] = 1; // 20% 砖墙
-                else if (randomValue < 25) m_layout[y][x] = 2; // 5% 钢墙
-                else if (randomValue < 40) m_layout[y][x] = 4; // 15% 水池 (ID 4)
+                if (randomValue < 20) setTileType(x, y, 1); // 20% 砖墙
+                else if (randomValue < 25) setTileType(x, y, 2); // 5% 钢墙
+                else if (randomValue < 40) setTileType(x, y, 4); // 15% 水池 (ID 4)
             } else if (level >= 3) {
-                if (randomValue < 15) m_layout[y][x] = 1; // 15% 砖墙
-                else if (randomValue < 20) m_layout[y][x] = 2; // 5% 钢墙
-                else if (randomValue < 35) m_layout[y][x] = 4; // 15% 水池
-                else if (randomValue < 50) m_layout[y][x] = 5; // 15% 森林 (ID 5)
+                if (randomValue < 15) setTileType(x, y, 1); // 15% 砖墙
+                else if (randomValue < 20) setTileType(x, y, 2); // 5% 钢墙
+                else if (randomValue < 35) setTileType(x, y, 4); // 15% 水池
+                else if (randomValue < 50) setTileType(x, y, 5); // 15% 森林 (ID 5)
             }
         }
     }
@@ -163,8 +198,8 @@ void Map::generateLayout(int level, std::mt19937& rng, const Game& game) {
                     // 不清除紧邻基地的保护墙 (y = basePos.y - 1, x = basePos.x +/- 1 or basePos.x)
                     bool isBaseProtection = (curY == basePos.y - 1 && curX >= basePos.x - 1 && curX <= basePos.x + 1) ||
                                             (curY == basePos.y && (curX == basePos.x -1 || curX == basePos.x+1));
-                    if (!isBaseProtection && m_layout[curY][curX] != 3) { // 不是基地本身且不是保护墙
-                        m_layout[curY][curX] = 0; // 清空为草地
+                    if (!isBaseProtection && tileTypeAt(curX, curY) != 3) { // 不是基地本身且不是保护墙
+                        setTileType(curX, curY, 0); // 清空为草地
                     }
                 }
             }
@@ -200,16 +235,16 @@ void Map::generateLayout(int level, std::mt19937& rng, const Game& game) {
                         isBaseArea = true; // 基地核心或紧邻的保护
                     }
                 }
-                if (!isBaseArea && m_layout[curY][curX] != 3) { // 不是基地核心
-                    m_layout[curY][curX] = 0; // 设置为草地 (可通行)
+                if (!isBaseArea && tileTypeAt(curX, curY) != 3) { // 不是基地核心
+                    setTileType(curX, curY, 0); // 设置为草地 (可通行)
                 }
             }
         }
     }
-    std::cout << "Cleared a potential player spawn region." << std::endl;
+    LOG_INFO("Cleared a potential player spawn region.");
 
     initializeTileHealth(); // 根据新布局设置砖墙血量
-    std::cout << "Map layout generated for level " << level << "." << std::endl;
+    LOG_INFO("Map layout generated for level " << level << ".");
 }
 
 void Map::resetForNewLevel() {
@@ -217,7 +252,7 @@ void Map::resetForNewLevel() {
     m_isBaseDestroyed = false;
     // 布局已由 generateLayout 处理，这里主要是重置状态
     initializeTileHealth(); // 确保砖墙血量基于当前布局被重置
-    std::cout << "Map state (base health, tile health) reset for new level." << std::endl;
+    LOG_INFO("Map state (base health, tile health) reset for new level.");
 }
 
 // =========================================================================
@@ -237,15 +272,15 @@ int Map::getTileType(int tileX, int tileY) const {
         // std::cerr << "Map::getTileType Error: Coordinates (" << tileX << "," << tileY << ") are out of bounds." << std::endl;
         return -1; // 超出边界返回无效类型
     }
-    return m_layout[tileY][tileX];
+    return tileTypeAt(tileX, tileY);
 }
 
 int Map::getTileHealth(int tileX, int tileY) const {
     if(tileX < 0 || tileY < 0 || tileX >= m_mapWidth || tileY >= m_mapHeight) {
         return -1; // 越界
     }
-    if (m_layout[tileY][tileX] == 1) { // 只有砖墙有这个独立的血量记录
-        return m_tileHealth[tileY][tileX];
+    if (tileTypeAt(tileX, tileY) == 1) { // 只有砖墙有这个独立的血量记录
+        return unpackHealth(m_grid.get(tileX, tileY));
     }
     return 0; // 其他类型的瓦片（如草地、钢墙）可以认为没有这种意义上的“血量”
 }
@@ -254,15 +289,8 @@ bool Map::isTileWalkable(int tileX, int tileY) const {
     if(tileX < 0 || tileY < 0 || tileX >= m_mapWidth || tileY >= m_mapHeight) {
         return false; // 超出边界
     }
-    int tileID = m_layout[tileY][tileX];
-    // 瓦片类型ID:
-    // 0: Grass (可通行)
-    // 1: Brick Wall (不可通行)
-    // 2: Steel Wall (不可通行)
-    // 3: Base (不可通行)
-    // 4: Water (不可通行)
-    // 5: Forest (可通行)
-    return (tileID == 0 || tileID == 5);
+    // 查所在块的可通行位图 (由 isWalkableType 派生，随 setTileType 同步更新)
+    return m_grid.isWalkable(tileX, tileY);
 }
 
 int Map::getBaseHealth() const {
@@ -273,25 +301,74 @@ bool Map::isBaseDestroyed() const {
     return m_isBaseDestroyed;
 }
 
+int Map::traceBulletPath(sf::Vector2f from, sf::Vector2f to, sf::Vector2i& hitTile) const {
+    const float tileW = static_cast<float>(m_tileWidth);
+    const float tileH = static_cast<float>(m_tileHeight);
+    if (tileW <= 0.f || tileH <= 0.f) return TRACE_CLEAR;
+
+    int x = static_cast<int>(std::floor(from.x / tileW));
+    int y = static_cast<int>(std::floor(from.y / tileH));
+    const int endX = static_cast<int>(std::floor(to.x / tileW));
+    const int endY = static_cast<int>(std::floor(to.y / tileH));
+
+    // Amanatides-Woo 网格遍历：tMax 为沿线段 (参数 0..1) 到达下一条竖/横格线的位置，tDelta 为跨过一整格所需的参数增量
+    const float dx = to.x - from.x;
+    const float dy = to.y - from.y;
+    const float inf = std::numeric_limits<float>::infinity();
+    const int stepX = (dx > 0.f) ? 1 : ((dx < 0.f) ? -1 : 0);
+    const int stepY = (dy > 0.f) ? 1 : ((dy < 0.f) ? -1 : 0);
+    float tMaxX = (stepX > 0) ? ((x + 1) * tileW - from.x) / dx : ((stepX < 0) ? (x * tileW - from.x) / dx : inf);
+    float tMaxY = (stepY > 0) ? ((y + 1) * tileH - from.y) / dy : ((stepY < 0) ? (y * tileH - from.y) / dy : inf);
+    const float tDeltaX = (stepX != 0) ? tileW / std::abs(dx) : inf;
+    const float tDeltaY = (stepY != 0) ? tileH / std::abs(dy) : inf;
+
+    // 途经格子数不会超过两端格子的曼哈顿距离 + 1 (防止浮点误差导致多走)
+    int remaining = std::abs(endX - x) + std::abs(endY - y);
+    while (true) {
+        hitTile = sf::Vector2i(x, y);
+        if (x < 0 || y < 0 || x >= m_mapWidth || y >= m_mapHeight) {
+            return TRACE_OUT_OF_BOUNDS;
+        }
+        int tileType = tileTypeAt(x, y);
+        if (blocksBullets(tileType)) {
+            return tileType;
+        }
+        if (remaining-- <= 0) {
+            return TRACE_CLEAR;
+        }
+        if (tMaxX < tMaxY) {
+            x += stepX;
+            tMaxX += tDeltaX;
+        } else {
+            y += stepY;
+            tMaxY += tDeltaY;
+        }
+    }
+}
+
 // =========================================================================
 // 状态修改方法
 // =========================================================================
-void Map::damageTile(int tileX, int tileY, int damage, Game& game) {
+void Map::damageTile(int tileX, int tileY, int damage, World& world) {
     if (tileX < 0 || tileY < 0 || tileX >= m_mapWidth || tileY >= m_mapHeight) {
         return; // 超出边界
     }
 
-    if (m_layout[tileY][tileX] == 1) { // 如果是砖墙 (ID 1)
-        if (m_tileHealth[tileY][tileX] > 0) {
-            m_tileHealth[tileY][tileX] -= damage;
-            // std::cout << "Brick at (" << tileX << "," << tileY << ") damaged. Health: " << m_tileHealth[y][x] << std::endl;
-
-            if (m_tileHealth[tileY][tileX] <= 0) {
-                m_layout[tileY][tileX] = 0; // 变为草地/空格 (ID 0)
-                m_tileHealth[tileY][tileX] = 0; // 确保健康值不为负
-                std::cout << "Brick at (" << tileX << "," << tileY << ") destroyed." << std::endl;
-                // 这里可以通知 Game 更新寻路或其他游戏逻辑，如果需要的话
+    if (tileTypeAt(tileX, tileY) == 1) { // 如果是砖墙 (ID 1)
+        int health = unpackHealth(m_grid.get(tileX, tileY));
+        if (health > 0) {
+            health -= damage;
+            // std::cout << "Brick at (" << tileX << "," << tileY << ") damaged. Health: " << health << std::endl;
+
+            if (health <= 0) {
+                m_grid.set(tileX, tileY, packTile(1, 0)); // 确保健康值不为负
+                setTileType(tileX, tileY, 0); // 变为草地/空格 (ID 0)，同时更新可通行位图
+                LOG_DEBUG("Brick at (" << tileX << "," << tileY << ") destroyed.");
+                // 这里可以通知 World 更新寻路或其他游戏逻辑，如果需要的话
+            } else {
+                m_grid.set(tileX, tileY, packTile(1, health));
             }
+            markTileChanged(tileX, tileY); // 血量或类型变化都会改变外观/可通行性
         }
     }
     // 其他类型的瓦片（如钢墙）目前不受子弹伤害，基地有单独的damageBase方法
@@ -300,12 +377,12 @@ void Map::damageTile(int tileX, int tileY, int damage, Game& game) {
 void Map::damageBase(int damage) {
     if (!m_isBaseDestroyed) {
         m_baseHealth -= damage;
-        std::cout << "Base damaged by " << damage << ". Current Base Health: " << m_baseHealth << std::endl;
+        LOG_DEBUG("Base damaged by " << damage << ". Current Base Health: " << m_baseHealth);
         if (m_baseHealth <= 0) {
             m_baseHealth = 0;
             m_isBaseDestroyed = true;
-            std::cout << "Base DESTROYED!" << std::endl;
-            // Game Over 逻辑将在 Game 类中处理 (通过检查 isBaseDestroyed())
+            LOG_INFO("Base DESTROYED!");
+            // Game Over 逻辑将在 Game 类中处理 (通过 World 检查 isBaseDestroyed())
         }
     }
 }
@@ -313,58 +390,181 @@ void Map::damageBase(int damage) {
 // =========================================================================
 // 绘制方法
 // =========================================================================
-void Map::draw(sf::RenderWindow &window, Game& game) {
-    if (m_layout.empty() || m_tileWidth == 0 || m_tileHeight == 0) {
-        // 如果地图未初始化或图块尺寸未知，则不绘制
-        // std::cerr << "Map::draw() - Warning: Layout empty or tile dimensions zero. Skipping draw." << std::endl;
+void Map::draw(sf::RenderWindow &window) {
+    if (m_grid.isEmpty() || m_tileWidth == 0 || m_tileHeight == 0 || !m_hasTileAtlas) {
+        // 如果地图未初始化、图块尺寸未知或图集未建立，则不绘制
         return;
     }
 
-    // 遍历地图布局
-    for (int y = 0; y < m_mapHeight; ++y) {
-        for (int x = 0; x < m_mapWidth; ++x) {
-            int tileID = m_layout[y][x];
-            std::string textureKey;
-
-            if (tileID == 1) { // 如果是砖墙 (ID 1)，根据血量选择不同纹理
-                int health = m_tileHealth[y][x]; // 注意：这里之前有个笔误，应该是 m_tileHealth[y][x]
-                if (health >= BRICK_INITIAL_HEALTH) { // 满血或更高 (以防万一)
-                    textureKey = "map_brick_wall";
-                } else if (health == 2) {
-                    textureKey = "map_brick_wall_damaged1"; // 假设你已将其添加到 config.json
-                } else if (health == 1) {
-                    textureKey = "map_brick_wall_damaged2"; // 假设你已将其添加到 config.json
-                } else { // health <= 0, 砖墙已被摧毁，逻辑上tileID应该已经是0了，这里为了安全显示为草地
-                    textureKey = "map_grass";
-                    if (m_layout[y][x] != 0) { // 如果布局ID还未更新为0，是个逻辑问题
-                        // std::cout << "Warning: Brick at (" << x << "," << y << ") has health " << health << " but layout ID is still 1." << std::endl;
-                    }
-                }
-            } else {
-                // 将 tileID 映射到 Game 缓存中纹理的键名
-                switch (tileID) {
-                    case 0: textureKey = "map_grass"; break;
-                    case 2: textureKey = "map_steel_wall"; break;
-                    case 3: textureKey = "map_base"; break;
-                    case 4: textureKey = "map_water"; break;   // 新增水
-                    case 5: textureKey = "map_forest"; break;  // 新增森林
-                    default:
-                        // std::cerr << "Map::draw() Warning: Unknown tile ID " << tileID << " at (" << x << "," << y << ")" << std::endl;
-                        continue; // 跳过未知ID 或绘制一个默认的错误图块
-                }
+    updateTileMesh();
+
+    // 只绘制与当前视图矩形相交的块，每块一次 draw 调用；视野外的块不生成顶点
+    const sf::View& view = window.getView();
+    const sf::Vector2f viewMin = view.getCenter() - view.getSize() / 2.f;
+    const sf::Vector2f viewMax = view.getCenter() + view.getSize() / 2.f;
+    const float chunkPixelW = static_cast<float>(m_tileWidth * TileChunkGrid::CHUNK_SIZE);
+    const float chunkPixelH = static_cast<float>(m_tileHeight * TileChunkGrid::CHUNK_SIZE);
+    const int minChunkX = std::max(0, static_cast<int>(std::floor(viewMin.x / chunkPixelW)));
+    const int minChunkY = std::max(0, static_cast<int>(std::floor(viewMin.y / chunkPixelH)));
+    const int maxChunkX = std::min(m_grid.getChunkColumns() - 1, static_cast<int>(std::floor(viewMax.x / chunkPixelW)));
+    const int maxChunkY = std::min(m_grid.getChunkRows() - 1, static_cast<int>(std::floor(viewMax.y / chunkPixelH)));
+    for (int cy = minChunkY; cy <= maxChunkY; ++cy) {
+        for (int cx = minChunkX; cx <= maxChunkX; ++cx) {
+            const size_t chunkIndex = static_cast<size_t>(cy) * m_grid.getChunkColumns() + cx;
+            if (!m_chunkMeshBuilt[chunkIndex]) buildChunkMesh(chunkIndex);
+            window.draw(m_chunkMeshes[chunkIndex], m_tileAtlas);
+        }
+    }
+}
+
+// =========================================================================
+// 块换入/换出
+// =========================================================================
+size_t Map::updateChunkResidency(const std::vector<sf::Vector2i>& activeTiles, int keepRadiusChunks) {
+    if (m_grid.isEmpty()) return 0;
+
+    const int columns = m_grid.getChunkColumns();
+    const int rows = m_grid.getChunkRows();
+    std::vector<std::uint8_t> keep(m_grid.getChunkCount(), 0);
+    for (const sf::Vector2i& tile : activeTiles) {
+        if (tile.x < 0 || tile.y < 0 || tile.x >= m_mapWidth || tile.y >= m_mapHeight) continue;
+        const int chunkX = tile.x >> TileChunkGrid::CHUNK_SHIFT;
+        const int chunkY = tile.y >> TileChunkGrid::CHUNK_SHIFT;
+        for (int cy = std::max(0, chunkY - keepRadiusChunks); cy <= std::min(rows - 1, chunkY + keepRadiusChunks); ++cy) {
+            for (int cx = std::max(0, chunkX - keepRadiusChunks); cx <= std::min(columns - 1, chunkX + keepRadiusChunks); ++cx) {
+                keep[static_cast<size_t>(cy) * columns + cx] = 1;
             }
+        }
+    }
 
-            const sf::Texture& texture = game.getTexture(textureKey); // 从 Game 获取纹理
+    // 远处块的顶点数组同样释放 (再次进入视野时重新生成)
+    for (size_t i = 0; i < keep.size(); ++i) {
+        if (!keep[i] && m_chunkMeshBuilt[i]) {
+            m_chunkMeshes[i] = sf::VertexArray();
+            m_chunkMeshBuilt[i] = 0;
+        }
+    }
+    return m_grid.updateResidency(keep);
+}
 
-            if (texture.getSize().x > 0 && texture.getSize().y > 0) { // 检查纹理是否有效
-                m_tileSprite.setTexture(texture);
-                m_tileSprite.setPosition(static_cast<float>(x * m_tileWidth), static_cast<float>(y * m_tileHeight));
-                window.draw(m_tileSprite);
-            } else {
-                // 这个警告可能在游戏运行时非常频繁，如果纹理确实缺失
-                // std::cerr << "Map::draw() Warning: Texture not found or invalid in Game cache for tile ID "
-                //           << tileID << " (key: " << textureKey << ") at (" << x << "," << y << ")" << std::endl;
-            }
+// =========================================================================
+// 瓦片图集与网格
+// =========================================================================
+bool Map::bindTileAtlas(const ResourceManager& resources) {
+    m_hasTileAtlas = false;
+    m_tileAtlas = nullptr;
+    if (m_tileWidth <= 0 || m_tileHeight <= 0) return false;
+
+    // 图集槽位顺序与 AtlasSlot 枚举一致
+    static const char* const slotKeys[ATLAS_SLOT_COUNT] = {
+            "map_grass", "map_brick_wall", "map_brick_wall_damaged1", "map_brick_wall_damaged2",
+            "map_steel_wall", "map_base", "map_water", "map_forest"
+    };
+
+    for (int slot = 0; slot < ATLAS_SLOT_COUNT; ++slot) {
+        m_slotRects[slot] = sf::IntRect();
+        const TextureRegion& region = resources.getTexture(slotKeys[slot]);
+        if (!region.isValid()) {
+            // 缺失的纹理不绘制，与原先跳过绘制的效果一致
+            LOG_WARN("Map::bindTileAtlas() - Warning: Texture '" << slotKeys[slot] << "' is missing; its tiles are not drawn.");
+            continue;
+        }
+        if (!m_tileAtlas) m_tileAtlas = region.texture;
+        if (region.texture != m_tileAtlas) {
+            LOG_WARN("Map::bindTileAtlas() - Warning: Texture '" << slotKeys[slot] << "' is not on the same atlas page as the other tiles; its tiles are not drawn.");
+            continue;
         }
+        // 只取左上角一个瓦片大小的区域
+        m_slotRects[slot] = sf::IntRect(region.rect.left, region.rect.top,
+                                        std::min(region.rect.width, m_tileWidth), std::min(region.rect.height, m_tileHeight));
+    }
+
+    m_hasTileAtlas = m_tileAtlas != nullptr;
+    if (m_hasTileAtlas) {
+        LOG_INFO("Map tile atlas bound: " << ATLAS_SLOT_COUNT << " slots on one atlas page.");
+    }
+    return m_hasTileAtlas;
+}
+
+int Map::atlasSlotAt(int tileX, int tileY) const {
+    std::uint8_t tile = m_grid.get(tileX, tileY);
+    switch (unpackType(tile)) {
+        case 0: return ATLAS_GRASS;
+        case 1: { // 砖墙根据血量选择不同纹理
+            int health = unpackHealth(tile);
+            if (health >= BRICK_INITIAL_HEALTH) return ATLAS_BRICK;
+            if (health == 2) return ATLAS_BRICK_DAMAGED1;
+            if (health == 1) return ATLAS_BRICK_DAMAGED2;
+            return ATLAS_GRASS; // 血量为0的砖墙逻辑上已变为草地，这里为了安全显示为草地
+        }
+        case 2: return ATLAS_STEEL;
+        case 3: return ATLAS_BASE;
+        case 4: return ATLAS_WATER;
+        case 5: return ATLAS_FOREST;
+        default: return -1; // 未知ID不绘制
+    }
+}
+
+void Map::writeTileQuad(int tileX, int tileY) {
+    const size_t local = static_cast<size_t>(((tileY & TileChunkGrid::CHUNK_MASK) << TileChunkGrid::CHUNK_SHIFT) |
+                                             (tileX & TileChunkGrid::CHUNK_MASK));
+    sf::Vertex* quad = &m_chunkMeshes[m_grid.chunkIndexOf(tileX, tileY)][local * 4];
+    int slot = atlasSlotAt(tileX, tileY);
+    const float left = static_cast<float>(tileX * m_tileWidth);
+    const float top = static_cast<float>(tileY * m_tileHeight);
+    const float w = static_cast<float>(m_tileWidth);
+    const float h = static_cast<float>(m_tileHeight);
+
+    if (slot < 0 || m_slotRects[slot].width <= 0) { // 退化为零面积四边形
+        for (int i = 0; i < 4; ++i) quad[i].position = sf::Vector2f(left, top);
+        return;
+    }
+    quad[0].position = sf::Vector2f(left, top);
+    quad[1].position = sf::Vector2f(left + w, top);
+    quad[2].position = sf::Vector2f(left + w, top + h);
+    quad[3].position = sf::Vector2f(left, top + h);
+
+    const sf::IntRect& rect = m_slotRects[slot];
+    const float u = static_cast<float>(rect.left);
+    const float v = static_cast<float>(rect.top);
+    const float texW = static_cast<float>(rect.width);
+    const float texH = static_cast<float>(rect.height);
+    quad[0].texCoords = sf::Vector2f(u, v);
+    quad[1].texCoords = sf::Vector2f(u + texW, v);
+    quad[2].texCoords = sf::Vector2f(u + texW, v + texH);
+    quad[3].texCoords = sf::Vector2f(u, v + texH);
+}
+
+void Map::buildChunkMesh(size_t chunkIndex) {
+    sf::VertexArray& mesh = m_chunkMeshes[chunkIndex];
+    mesh.setPrimitiveType(sf::Quads);
+    mesh.resize(static_cast<size_t>(TileChunkGrid::CHUNK_TILES) * 4); // 地图边缘的块超出部分保持零面积四边形
+
+    const int originX = static_cast<int>(chunkIndex % m_grid.getChunkColumns()) * TileChunkGrid::CHUNK_SIZE;
+    const int originY = static_cast<int>(chunkIndex / m_grid.getChunkColumns()) * TileChunkGrid::CHUNK_SIZE;
+    const int endX = std::min(m_mapWidth, originX + TileChunkGrid::CHUNK_SIZE);
+    const int endY = std::min(m_mapHeight, originY + TileChunkGrid::CHUNK_SIZE);
+    for (int y = originY; y < endY; ++y) {
+        for (int x = originX; x < endX; ++x) {
+            writeTileQuad(x, y);
+        }
+    }
+    m_chunkMeshBuilt[chunkIndex] = 1;
+}
+
+void Map::updateTileMesh() {
+    if (m_meshGeneration != m_layoutGeneration || m_chunkMeshBuilt.size() != m_grid.getChunkCount()) {
+        // 布局整体重建：所有块的网格作废，绘制时按需重新生成
+        m_chunkMeshBuilt.assign(m_grid.getChunkCount(), 0);
+        m_chunkMeshes.resize(m_grid.getChunkCount());
+        m_meshGeneration = m_layoutGeneration;
+        m_meshChangeCursor = m_tileChangeLog.size();
+        return;
+    }
+    // 只重写自上次绘制以来变化过的瓦片 (同一瓦片多次变化时重复写入，结果相同)；
+    // 网格尚未生成的块在生成时自然读到最新瓦片
+    for (; m_meshChangeCursor < m_tileChangeLog.size(); ++m_meshChangeCursor) {
+        const sf::Vector2i& tile = m_tileChangeLog[m_meshChangeCursor];
+        if (m_chunkMeshBuilt[m_grid.chunkIndexOf(tile.x, tile.y)]) writeTileQuad(tile.x, tile.y);
     }
 }
@@ -6,14 +6,40 @@
 #include <vector>
 #include <map>
 #include <random> // For std::mt19937
+#include <cstdint>
+#include "TileChunkGrid.h" // 分块瓦片存储
 
-class Game; // Game的完整定义不需要，但Game&会用到
+class World;           // World的完整定义不需要，但World&会用到
+class ResourceManager; // 纹理来源 (无界面模式下为空)
 
 class Map {
 private:
-    std::vector<std::vector<int>> m_layout;
-    std::vector<std::vector<int>> m_tileHealth;
-    sf::Sprite m_tileSprite;
+    // 瓦片网格：32x32 分块懒分配，每格一个字节 (低4位: 瓦片类型ID, 高4位: 砖墙血量)；
+    // 每块自带可通行位图，远离实体的块可换出为紧凑形式 (见 updateChunkResidency)
+    TileChunkGrid m_grid;
+
+    // 瓦片图集：所有地图瓦片位于 ResourceManager 图集的同一页 (最先打包)，
+    // draw() 每个可见块用一个顶点数组一次绘制
+    enum AtlasSlot {
+        ATLAS_GRASS, ATLAS_BRICK, ATLAS_BRICK_DAMAGED1, ATLAS_BRICK_DAMAGED2,
+        ATLAS_STEEL, ATLAS_BASE, ATLAS_WATER, ATLAS_FOREST,
+        ATLAS_SLOT_COUNT
+    };
+    const sf::Texture* m_tileAtlas;            // 瓦片所在的图集页 (由 ResourceManager 持有)
+    sf::IntRect m_slotRects[ATLAS_SLOT_COUNT]; // 各槽位在图集页中的矩形 (缺失的纹理为空矩形，不绘制)
+    bool m_hasTileAtlas;
+    std::vector<sf::VertexArray> m_chunkMeshes;  // 每块一个顶点数组 (每格4个顶点，sf::Quads)，进入视野时才生成
+    std::vector<std::uint8_t> m_chunkMeshBuilt;  // 对应块的顶点数组是否有效
+    std::uint32_t m_meshGeneration; // 顶点数组对应的布局代数 (不一致时全部作废)
+    size_t m_meshChangeCursor;      // 顶点数组已处理到的变更日志位置
+
+    // 瓦片变更记录：布局整体重建 (生成/重置) 时代数加一并清空日志；
+    // 之后每次单个瓦片变化 (砖墙受损/被摧毁) 追加一条坐标。
+    // 使用者 (地图网格、寻路缓存、小地图等) 各自保存 (代数, 日志位置)，
+    // 代数变化时整体重建，否则只处理日志中新增的部分。
+    std::uint32_t m_layoutGeneration;
+    std::vector<sf::Vector2i> m_tileChangeLog;
+
     int m_tileWidth;
     int m_tileHeight;
     int m_mapWidth;  // 地图宽度 (格子数)
@@ -24,12 +50,28 @@ private:
 
     // void initMapLayout(); // 将被 generateLayout 取代或其逻辑并入
     void initializeTileHealth(); // 新增：辅助函数，根据布局初始化砖墙血量
+    void resizeGrid();           // 按当前地图尺寸重置网格 (全部为草地，不分配任何块)
+    void setTileType(int tileX, int tileY, int tileType); // 修改类型 (保留血量位)，同步可通行位
+
+    bool bindTileAtlas(const ResourceManager& resources);  // 加载时取得各瓦片在图集中的子区域
+    int atlasSlotAt(int tileX, int tileY) const;           // 瓦片对应的图集槽位 (-1: 不绘制)
+    void writeTileQuad(int tileX, int tileY);              // 更新一个瓦片的4个顶点 (所在块的网格须已生成)
+    void buildChunkMesh(size_t chunkIndex);                // 生成一个块的顶点
+    void updateTileMesh();                                 // 按变更日志只更新已生成网格中变化的瓦片
+    void markTileChanged(int tileX, int tileY);            // 追加一条瓦片变更记录
+
+    int tileTypeAt(int tileX, int tileY) const { return unpackType(m_grid.get(tileX, tileY)); } // 不做边界检查
+    static std::uint8_t packTile(int tileType, int health) { return static_cast<std::uint8_t>((tileType & 0x0F) | ((health & 0x0F) << 4)); }
+    static int unpackType(std::uint8_t tile) { return tile & 0x0F; }
+    static int unpackHealth(std::uint8_t tile) { return tile >> 4; }
+    static bool isWalkableType(int tileType) { return tileType == 0 || tileType == 5; } // 草地与森林可通行
+    static bool isWalkableTile(std::uint8_t tile) { return isWalkableType(unpackType(tile)); }
 
 public:
     static const int BRICK_INITIAL_HEALTH = 3;
     static const int BASE_INITIAL_HEALTH = 200; // 基地初始血量
 
-    // 地图瓦片类型ID (与config.json和Game::getTexture中的键名对应)
+    // 地图瓦片类型ID (与config.json和ResourceManager::getTexture中的键名对应)
     // 0: Grass (map_grass)
     // 1: Brick Wall (map_brick_wall, map_brick_wall_damaged1, map_brick_wall_damaged2)
     // 2: Steel Wall (map_steel_wall)
@@ -38,9 +80,10 @@ public:
     // 5: Forest (map_forest) - 新增
 
     Map();
-    bool loadDimensionsAndTextures(Game& game); // 修改：只加载尺寸和纹理信息，布局由generateLayout处理
-    void generateLayout(int level, std::mt19937& rng, const Game& game); // 新增：根据关卡生成地图布局
-    void draw(sf::RenderWindow &window, Game& game);
+    bool loadDimensionsAndTextures(const ResourceManager* resources); // 只加载尺寸和纹理信息，布局由generateLayout处理；resources 为空时使用默认瓦片尺寸
+    void setMapSize(int widthTiles, int heightTiles); // 覆盖默认地图尺寸 (config.json "map")，下一次 generateLayout 生效
+    void generateLayout(int level, std::mt19937& rng, const World& world); // 新增：根据关卡生成地图布局
+    void draw(sf::RenderWindow &window); // 只绘制与当前视图相交的块 (每块一个顶点数组 + 瓦片图集)
     bool isTileWalkable(int tileX, int tileY) const;
     int getTileWidth() const { return m_tileWidth; };
     int getTileHeight() const { return m_tileHeight; };
@@ -49,13 +92,30 @@ public:
     int getMapWidth() const { return m_mapWidth; }
     int getMapHeight() const { return m_mapHeight; }
     int getTileType(int tileX, int tileY) const;
+    static bool blocksBullets(int tileType) { return tileType == 1 || tileType == 2 || tileType == 3; } // 砖墙/钢墙/基地阻挡子弹
+
+    // 子弹扫掠检测：沿线段 from -> to 用网格 DDA 逐格前进，找出途经的第一个阻挡子弹的瓦片。
+    // 返回该瓦片类型 (1/2/3)；途中离开地图返回 TRACE_OUT_OF_BOUNDS；无阻挡返回 TRACE_CLEAR。
+    // hitTile 为命中 (或越界) 的格子坐标。
+    static const int TRACE_CLEAR = 0;
+    static const int TRACE_OUT_OF_BOUNDS = -1;
+    int traceBulletPath(sf::Vector2f from, sf::Vector2f to, sf::Vector2i& hitTile) const;
 
     int getTileHealth(int tileX, int tileY) const; // 获取砖墙血量
-    void damageTile(int tileX, int tileY, int damage, Game& game); // 砖墙受损
+
+    // 瓦片变更记录 (见 m_tileChangeLog 说明)
+    std::uint32_t getLayoutGeneration() const { return m_layoutGeneration; }
+    const std::vector<sf::Vector2i>& getTileChangeLog() const { return m_tileChangeLog; }
+    void damageTile(int tileX, int tileY, int damage, World& world); // 砖墙受损
     void damageBase(int damage); // 基地受损
     int getBaseHealth() const;
     bool isBaseDestroyed() const;
     void resetForNewLevel(); // 新增：重置地图状态（血量等），但不重新生成布局
+
+    // 块换入/换出：距离任一活动格 keepRadiusChunks 个块以内的块保持完整存储，
+    // 更远的块换出为紧凑形式并释放其顶点数组。返回状态发生变化的块数
+    size_t updateChunkResidency(const std::vector<sf::Vector2i>& activeTiles, int keepRadiusChunks);
+    const TileChunkGrid& getTileGrid() const { return m_grid; } // 块统计 (性能对比用)
 };
 
 #endif //TANKS_MAP_H
\ No newline at end of file
@@ -0,0 +1,87 @@
+// PathRequestQueue.cpp
+#include "PathRequestQueue.h"
+#include "AITank.h"
+#include "Map.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib> // std::abs
+
+PathRequestQueue::PathRequestQueue()
+        : m_budgetMicros(0), m_maxRequestsPerTick(0) {
+}
+
+void PathRequestQueue::configure(int budgetMicros, int maxRequestsPerTick) {
+    m_budgetMicros = std::max(0, budgetMicros);
+    m_maxRequestsPerTick = std::max(0, maxRequestsPerTick);
+}
+
+// =========================================================================
+// 请求管理
+// =========================================================================
+void PathRequestQueue::submit(AITank* tank, std::uint64_t tick) {
+    if (!tank || tank->isPathRequestPending()) return;
+    tank->setPathRequestPending(true);
+    m_pending.push_back({tank, tick, 0});
+}
+
+void PathRequestQueue::removeDestroyed() {
+    m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(),
+                                   [](const Request& request) { return request.tank->isDestroyed(); }),
+                    m_pending.end());
+}
+
+void PathRequestQueue::clear() {
+    for (const Request& request : m_pending) {
+        request.tank->setPathRequestPending(false);
+    }
+    m_pending.clear();
+}
+
+// =========================================================================
+// 按预算处理
+// =========================================================================
+void PathRequestQueue::process(const Map& map, const Tank* playerTank, std::uint64_t tick) {
+    if (m_pending.empty()) return;
+
+    // 计算优先级：原地待命 (没有旧路径可走) 的坦克排在前面，其次按离玩家的曼哈顿距离减去排队时长
+    const int tileW = std::max(1, map.getTileWidth());
+    const int tileH = std::max(1, map.getTileHeight());
+    const int playerX = playerTank ? static_cast<int>(playerTank->get_position().x) / tileW : 0;
+    const int playerY = playerTank ? static_cast<int>(playerTank->get_position().y) / tileH : 0;
+    const int idleBonus = (map.getMapWidth() + map.getMapHeight()) * 4;
+    for (Request& request : m_pending) {
+        const sf::Vector2f position = request.tank->get_position();
+        const int distance = std::abs(static_cast<int>(position.x) / tileW - playerX) +
+                             std::abs(static_cast<int>(position.y) / tileH - playerY);
+        const int waited = static_cast<int>(std::min<std::uint64_t>(tick - request.submittedTick, 1u << 20));
+        request.priority = distance - waited * AGING_TILES_PER_TICK - (request.tank->hasPursuitPath() ? 0 : idleBonus);
+    }
+    std::stable_sort(m_pending.begin(), m_pending.end(),
+                     [](const Request& a, const Request& b) { return a.priority < b.priority; });
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    double elapsedMicros = 0.0;
+    size_t processed = 0;
+    size_t i = 0;
+    for (; i < m_pending.size(); ++i) {
+        if (processed > 0) {
+            if (m_maxRequestsPerTick > 0 && processed >= static_cast<size_t>(m_maxRequestsPerTick)) break;
+            if (m_budgetMicros > 0 && elapsedMicros >= m_budgetMicros) break;
+        }
+        Request& request = m_pending[i];
+        m_stats.maxWaitTicks = std::max(m_stats.maxWaitTicks, tick - request.submittedTick);
+        request.tank->setPathRequestPending(false);
+        request.tank->planPursuit(map, playerTank);
+        ++processed;
+        elapsedMicros = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    }
+
+    m_stats.processed += processed;
+    m_stats.totalMicros += elapsedMicros;
+    m_stats.maxTickMicros = std::max(m_stats.maxTickMicros, elapsedMicros);
+
+    // 未处理的请求留到下一tick (届时重新计算优先级)
+    if (i < m_pending.size()) ++m_stats.deferredTicks;
+    m_pending.erase(m_pending.begin(), m_pending.begin() + static_cast<std::ptrdiff_t>(i));
+}
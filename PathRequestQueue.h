@@ -0,0 +1,67 @@
+#ifndef TANKS_PATHREQUESTQUEUE_H
+#define TANKS_PATHREQUESTQUEUE_H
+
+// =========================================================================
+// 必要的头文件包含
+// =========================================================================
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class AITank;
+class Map;
+class Tank;
+
+// 寻路请求队列的统计 (性能对比用)
+struct PathQueueStats {
+    size_t processed = 0;           // 累计完成的请求数
+    size_t deferredTicks = 0;       // 有请求因预算用完而推迟到下一tick的tick数
+    std::uint64_t maxWaitTicks = 0; // 单个请求最长的排队tick数
+    double totalMicros = 0.0;       // 累计寻路耗时 (微秒)
+    double maxTickMicros = 0.0;     // 单个tick内最大的寻路耗时 (微秒)
+};
+
+// =========================================================================
+// PathRequestQueue: 按每tick时间预算分摊的寻路请求队列
+// =========================================================================
+// 追击型AI每到达一个格子中心就提交一次请求，World 在AI决策前调用 process()。
+// 请求按优先级处理：没有可用旧路径的 (原地待命) 优先，其次离玩家近的；
+// 排队越久优先级越高，避免远处的坦克一直饿死。本tick的预算 (微秒) 或数量上限用完后，
+// 剩余请求留到下一tick，等待期间坦克继续沿上一次规划的路径行进。
+// 每tick至少处理一个请求，保证队列总能前进。
+class PathRequestQueue {
+public:
+    PathRequestQueue();
+
+    // budgetMicros: 每tick寻路时间预算 (0 表示不限，结果与机器速度无关，可复现)
+    // maxRequestsPerTick: 每tick最多处理的请求数 (0 表示不限)
+    void configure(int budgetMicros, int maxRequestsPerTick);
+
+    void submit(AITank* tank, std::uint64_t tick); // 提交请求 (同一坦克已在队列中时忽略)
+    void removeDestroyed();                        // 移除已被摧毁坦克的请求 (须在释放坦克对象之前调用)
+    void clear();
+
+    // 在预算内按优先级处理请求
+    void process(const Map& map, const Tank* playerTank, std::uint64_t tick);
+
+    size_t getPendingCount() const { return m_pending.size(); }
+    int getBudgetMicros() const { return m_budgetMicros; }
+    int getMaxRequestsPerTick() const { return m_maxRequestsPerTick; }
+    const PathQueueStats& getStats() const { return m_stats; }
+
+    static constexpr int AGING_TILES_PER_TICK = 1; // 每排队一个tick，相当于离玩家近一格
+
+private:
+    struct Request {
+        AITank* tank;
+        std::uint64_t submittedTick;
+        int priority; // process() 时计算，越小越先处理
+    };
+
+    std::vector<Request> m_pending;  // 同优先级时保持原有顺序 (稳定排序)
+    int m_budgetMicros;
+    int m_maxRequestsPerTick;
+    PathQueueStats m_stats;
+};
+
+#endif //TANKS_PATHREQUESTQUEUE_H
@@ -0,0 +1,94 @@
+// Profiler.cpp
+#include "Profiler.h"
+#include "Log.h"
+#include <algorithm> // std::min, std::max, std::nth_element
+#include <cmath>     // std::ceil
+#include <fstream>
+
+const char* getProfilePhaseName(ProfilePhase phase) {
+    switch (phase) {
+        case ProfilePhase::TankUpdate:      return "tank_update";
+        case ProfilePhase::AIDecision:      return "ai_decision";
+        case ProfilePhase::TankCollision:   return "tank_collision";
+        case ProfilePhase::BulletMove:      return "bullet_move";
+        case ProfilePhase::BulletCollision: return "bullet_collision";
+        case ProfilePhase::Tools:           return "tools";
+        case ProfilePhase::Spawning:        return "spawning";
+        case ProfilePhase::Cleanup:         return "cleanup";
+        case ProfilePhase::RenderMap:       return "render_map";
+        case ProfilePhase::RenderEntities:  return "render_entities";
+        case ProfilePhase::RenderUI:        return "render_ui";
+        default:                            return "unknown";
+    }
+}
+
+FrameProfiler::FrameProfiler(size_t historyFrames)
+        : m_capacity(0), m_next(0), m_stored(0), m_frameCount(0) {
+    setHistoryFrames(historyFrames);
+}
+
+void FrameProfiler::setHistoryFrames(size_t historyFrames) {
+    m_capacity = std::max<size_t>(1, historyFrames);
+    m_history.assign(m_capacity * PHASE_COUNT, 0.f);
+    m_scratch.reserve(m_capacity);
+    m_next = 0;
+    m_stored = 0;
+    m_current.fill(0.0);
+}
+
+void FrameProfiler::endFrame() {
+    float* row = &m_history[m_next * PHASE_COUNT];
+    for (size_t phase = 0; phase < PHASE_COUNT; ++phase) {
+        row[phase] = static_cast<float>(m_current[phase]);
+    }
+    m_current.fill(0.0);
+    m_next = (m_next + 1) % m_capacity;
+    m_stored = std::min(m_stored + 1, m_capacity);
+    ++m_frameCount;
+}
+
+FrameProfiler::PhaseStats FrameProfiler::getStats(ProfilePhase phase, size_t windowFrames) const {
+    PhaseStats stats;
+    const size_t count = std::min(windowFrames, m_stored);
+    if (count == 0) return stats;
+
+    // 取最近 count 帧 (m_next 之前)，再用 nth_element 求 p99，不对整个窗口排序
+    m_scratch.clear();
+    double total = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        const size_t frame = (m_next + m_capacity - 1 - i) % m_capacity;
+        const float micros = m_history[frame * PHASE_COUNT + static_cast<size_t>(phase)];
+        m_scratch.push_back(micros);
+        total += micros;
+        stats.maxMicros = std::max(stats.maxMicros, static_cast<double>(micros));
+    }
+    stats.averageMicros = total / static_cast<double>(count);
+    const size_t rank = static_cast<size_t>(std::ceil(0.99 * static_cast<double>(count))) - 1;
+    std::nth_element(m_scratch.begin(), m_scratch.begin() + static_cast<std::ptrdiff_t>(rank), m_scratch.end());
+    stats.p99Micros = m_scratch[rank];
+    return stats;
+}
+
+bool FrameProfiler::writeCsv(const std::string& path) const {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_ERROR("FrameProfiler::writeCsv() - Error: Failed to open '" << path << "' for writing.");
+        return false;
+    }
+    file << "frame";
+    for (size_t phase = 0; phase < PHASE_COUNT; ++phase) {
+        file << ',' << getProfilePhaseName(static_cast<ProfilePhase>(phase)) << "_us";
+    }
+    file << '\n';
+
+    const size_t oldest = (m_next + m_capacity - m_stored) % m_capacity;
+    const std::uint64_t firstFrame = m_frameCount - m_stored;
+    for (size_t i = 0; i < m_stored; ++i) {
+        const float* row = &m_history[((oldest + i) % m_capacity) * PHASE_COUNT];
+        file << firstFrame + i;
+        for (size_t phase = 0; phase < PHASE_COUNT; ++phase) file << ',' << row[phase];
+        file << '\n';
+    }
+    LOG_INFO("Frame profile written to '" << path << "' (" << m_stored << " frames).");
+    return file.good();
+}
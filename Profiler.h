@@ -0,0 +1,113 @@
+#ifndef TANKS_PROFILER_H
+#define TANKS_PROFILER_H
+
+// =========================================================================
+// 必要的头文件包含
+// =========================================================================
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Trace.h" // 记录 trace 时各阶段同时写出 trace 事件
+
+// 被计时的阶段：模拟部分对应 World::step 的编号步骤，渲染部分对应 Game::render 的三个绘制阶段
+enum class ProfilePhase : std::uint8_t {
+    TankUpdate,      // 1-3. 记录上一位置、玩家移动、坦克基础状态
+    AIDecision,      // 4.   流场同步、寻路请求、AI决策与射击
+    TankCollision,   // 5.   坦克间碰撞
+    BulletMove,      // 6.   子弹移动
+    BulletCollision, // 7.   子弹与坦克/地图的碰撞
+    Tools,           // 8.   道具
+    Spawning,        // 9.   AI坦克生成
+    Cleanup,         // 10-11. 清理被摧毁的坦克、地图块换出
+    RenderMap,
+    RenderEntities,
+    RenderUI,
+    Count
+};
+
+const char* getProfilePhaseName(ProfilePhase phase); // 例如 "tank_update" (CSV 列名与界面显示共用)
+
+// =========================================================================
+// FrameProfiler: 每帧各阶段耗时的滚动记录
+// =========================================================================
+// 一帧内同一阶段可被多次计时 (例如一帧补算多个模拟tick)，耗时累加；endFrame() 时把本帧结果写入
+// 环形历史 (容量 historyFrames 帧，预先分配)，getStats() 按最近 windowFrames 帧计算平均值与 p99。
+class FrameProfiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct PhaseStats {
+        double averageMicros = 0.0;
+        double p99Micros = 0.0;
+        double maxMicros = 0.0;
+    };
+
+    explicit FrameProfiler(size_t historyFrames = 3600);
+
+    void setHistoryFrames(size_t historyFrames); // 清空已有历史
+    void record(ProfilePhase phase, Clock::time_point start, Clock::time_point end) {
+        m_current[static_cast<size_t>(phase)] += std::chrono::duration<double, std::micro>(end - start).count();
+        TraceRecorder& tracer = TraceRecorder::instance();
+        if (tracer.isRecording()) tracer.record(getProfilePhaseName(phase), start, end);
+    }
+    void endFrame();
+
+    PhaseStats getStats(ProfilePhase phase, size_t windowFrames) const;
+    size_t getStoredFrameCount() const { return m_stored; }
+    std::uint64_t getFrameCount() const { return m_frameCount; }
+
+    bool writeCsv(const std::string& path) const; // 每行一帧 (按时间顺序)，每列一个阶段 (微秒)
+
+private:
+    static const size_t PHASE_COUNT = static_cast<size_t>(ProfilePhase::Count);
+
+    size_t m_capacity;
+    std::vector<float> m_history;              // m_capacity 帧 × PHASE_COUNT
+    size_t m_next;                             // 下一帧写入的位置
+    size_t m_stored;                           // 已保存的帧数 (不超过容量)
+    std::uint64_t m_frameCount;                // 累计帧数 (CSV 的帧号)
+    std::array<double, PHASE_COUNT> m_current; // 本帧累计耗时 (微秒)
+    mutable std::vector<float> m_scratch;      // 计算 p99 的临时缓冲
+};
+
+// =========================================================================
+// 计时工具 (profiler 为 nullptr 时不计时)
+// =========================================================================
+// ProfileScope: 作用域计时，离开作用域时记录
+class ProfileScope {
+public:
+    ProfileScope(FrameProfiler* profiler, ProfilePhase phase)
+            : m_profiler(profiler), m_phase(phase), m_start(profiler ? FrameProfiler::Clock::now() : FrameProfiler::Clock::time_point()) {}
+    ~ProfileScope() {
+        if (m_profiler) m_profiler->record(m_phase, m_start, FrameProfiler::Clock::now());
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    FrameProfiler* m_profiler;
+    ProfilePhase m_phase;
+    FrameProfiler::Clock::time_point m_start;
+};
+
+// PhaseTimer: 依次执行的多个阶段，lap(phase) 把上一次 lap 以来的耗时记到 phase 上
+class PhaseTimer {
+public:
+    explicit PhaseTimer(FrameProfiler* profiler)
+            : m_profiler(profiler), m_last(profiler ? FrameProfiler::Clock::now() : FrameProfiler::Clock::time_point()) {}
+    void lap(ProfilePhase phase) {
+        if (!m_profiler) return;
+        const FrameProfiler::Clock::time_point now = FrameProfiler::Clock::now();
+        m_profiler->record(phase, m_last, now);
+        m_last = now;
+    }
+
+private:
+    FrameProfiler* m_profiler;
+    FrameProfiler::Clock::time_point m_last;
+};
+
+#endif //TANKS_PROFILER_H
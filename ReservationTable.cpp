@@ -0,0 +1,186 @@
+// ReservationTable.cpp
+#include "ReservationTable.h"
+#include "Map.h"
+#include "tank.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// 4个移动方向 + 原地等待
+const int ACTION_DX[5] = {0, 0, -1, 1, 0};
+const int ACTION_DY[5] = {-1, 1, 0, 0, 0};
+}
+
+ReservationTable::ReservationTable()
+        : m_width(0), m_height(0), m_currentTick(0), m_secondsPerTick(1.f / 120.f),
+          m_plans(0), m_waits(0), m_expansions(0) {
+}
+
+void ReservationTable::configure(int width, int height) {
+    m_width = std::max(0, width);
+    m_height = std::max(0, height);
+    m_slots.clear();
+    m_ownerTiles.clear();
+}
+
+void ReservationTable::clear() {
+    m_slots.clear();
+    m_ownerTiles.clear();
+}
+
+void ReservationTable::beginTick(std::uint64_t tick, float secondsPerTick) {
+    m_currentTick = tick;
+    if (secondsPerTick > 0.f) m_secondsPerTick = secondsPerTick;
+}
+
+std::uint64_t ReservationTable::ticksPerStep(float speedPixelsPerSecond, int tileSize) const {
+    if (speedPixelsPerSecond <= 0.f || tileSize <= 0) return 1;
+    const float ticks = static_cast<float>(tileSize) / (speedPixelsPerSecond * m_secondsPerTick);
+    return std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(ticks)));
+}
+
+// =========================================================================
+// 预留查询与修改
+// =========================================================================
+void ReservationTable::pruneExpired(std::vector<Reservation>& slots) const {
+    slots.erase(std::remove_if(slots.begin(), slots.end(),
+                               [this](const Reservation& r) { return r.to <= m_currentTick; }),
+                slots.end());
+}
+
+bool ReservationTable::isFree(sf::Vector2i tile, std::uint64_t from, std::uint64_t to, const Tank* owner) const {
+    if (!inBounds(tile)) return false;
+    auto it = m_slots.find(tile.y * m_width + tile.x);
+    if (it == m_slots.end()) return true;
+    for (const Reservation& r : it->second) {
+        if (r.owner != owner && r.from < to && from < r.to) return false;
+    }
+    return true;
+}
+
+void ReservationTable::reserve(sf::Vector2i tile, std::uint64_t from, std::uint64_t to, const Tank* owner) {
+    if (!inBounds(tile) || from >= to) return;
+    const int index = tile.y * m_width + tile.x;
+    std::vector<Reservation>& slots = m_slots[index];
+    pruneExpired(slots);
+    // 同一坦克相邻/重叠的时间段合并为一条
+    for (Reservation& r : slots) {
+        if (r.owner == owner && r.from <= to && from <= r.to) {
+            r.from = std::min(r.from, from);
+            r.to = std::max(r.to, to);
+            return;
+        }
+    }
+    slots.push_back({from, to, owner});
+    m_ownerTiles[owner].push_back(index);
+}
+
+void ReservationTable::release(const Tank* owner) {
+    auto it = m_ownerTiles.find(owner);
+    if (it == m_ownerTiles.end()) return;
+    for (int index : it->second) {
+        auto slotIt = m_slots.find(index);
+        if (slotIt == m_slots.end()) continue;
+        std::vector<Reservation>& slots = slotIt->second;
+        slots.erase(std::remove_if(slots.begin(), slots.end(),
+                                   [owner](const Reservation& r) { return r.owner == owner; }),
+                    slots.end());
+        if (slots.empty()) m_slots.erase(slotIt); // 空列表不保留，表的大小只随活动坦克数增长
+    }
+    m_ownerTiles.erase(it);
+}
+
+void ReservationTable::releaseDestroyed() {
+    std::vector<const Tank*> destroyed;
+    for (const auto& entry : m_ownerTiles) {
+        if (entry.first->isDestroyed()) destroyed.push_back(entry.first);
+    }
+    for (const Tank* owner : destroyed) release(owner);
+}
+
+void ReservationTable::holdTile(const Tank* owner, sf::Vector2i tile, std::uint64_t ticksPerStep) {
+    release(owner);
+    reserve(tile, m_currentTick, m_currentTick + ticksPerStep * WINDOW_STEPS, owner);
+}
+
+// =========================================================================
+// 窗口化时空 A*
+// =========================================================================
+bool ReservationTable::planWindow(const Map& map, const Tank* owner, sf::Vector2i start, std::uint64_t ticksPerStep,
+                                  const std::function<std::uint32_t(sf::Vector2i)>& heuristic, sf::Vector2i& firstStep) {
+    ++m_plans;
+    firstStep = start;
+    if (!inBounds(start)) return false;
+
+    const std::uint64_t cellCount = static_cast<std::uint64_t>(m_width) * m_height;
+    const std::uint32_t startH = heuristic(start);
+    if (startH == UINT32_MAX) return false;
+
+    m_open.clear();
+    m_parent.clear();
+    const std::uint64_t startState = static_cast<std::uint64_t>(start.y * m_width + start.x);
+    m_open.push_back({startH, startH, startState});
+    m_parent[startState] = startState;
+
+    std::uint64_t goalState = startState;
+    bool found = false;
+    while (!m_open.empty()) {
+        std::pop_heap(m_open.begin(), m_open.end(), std::greater<>());
+        const Node node = m_open.back();
+        m_open.pop_back();
+        ++m_expansions;
+
+        const int step = static_cast<int>(node.state / cellCount);
+        const int index = static_cast<int>(node.state % cellCount);
+        if (step == WINDOW_STEPS) { // 窗口末端：剩余部分交给启发值
+            goalState = node.state;
+            found = true;
+            break;
+        }
+
+        const sf::Vector2i tile(index % m_width, index / m_width);
+        const std::uint64_t from = m_currentTick + static_cast<std::uint64_t>(step) * ticksPerStep;
+        const std::uint64_t to = from + ticksPerStep;
+        for (int a = 0; a < 5; ++a) {
+            const sf::Vector2i next(tile.x + ACTION_DX[a], tile.y + ACTION_DY[a]);
+            const bool wait = (a == 4);
+            if (!wait && !map.isTileWalkable(next.x, next.y)) continue;
+            // 这一步期间要占用目标格；移动时出发格也仍被车身占着
+            if (!isFree(next, from, to, owner)) continue;
+            if (!wait && !isFree(tile, from, to, owner)) continue;
+
+            const std::uint32_t h = heuristic(next);
+            if (h == UINT32_MAX) continue;
+            const std::uint64_t nextState = static_cast<std::uint64_t>(step + 1) * cellCount + (next.y * m_width + next.x);
+            if (m_parent.count(nextState)) continue; // 每个时空状态只入队一次 (各步代价相同，先到即最优)
+            m_parent[nextState] = node.state;
+            m_open.push_back({static_cast<std::uint32_t>(step + 1) + h, h, nextState});
+            std::push_heap(m_open.begin(), m_open.end(), std::greater<>());
+        }
+    }
+
+    release(owner);
+    if (!found) {
+        // 连原地等待都会冲突：仍占住当前格一步，交给碰撞处理兜底
+        reserve(start, m_currentTick, m_currentTick + ticksPerStep, owner);
+        ++m_waits;
+        return false;
+    }
+
+    // 回溯窗口路径 (m_pathScratch[k] = 第k步结束时所在格)
+    m_pathScratch.assign(WINDOW_STEPS + 1, 0);
+    for (std::uint64_t state = goalState;; state = m_parent[state]) {
+        m_pathScratch[state / cellCount] = static_cast<int>(state % cellCount);
+        if (state == startState) break;
+    }
+    for (int k = 0; k < WINDOW_STEPS; ++k) {
+        const std::uint64_t from = m_currentTick + static_cast<std::uint64_t>(k) * ticksPerStep;
+        const std::uint64_t to = from + ticksPerStep;
+        reserve(sf::Vector2i(m_pathScratch[k] % m_width, m_pathScratch[k] / m_width), from, to, owner);
+        reserve(sf::Vector2i(m_pathScratch[k + 1] % m_width, m_pathScratch[k + 1] / m_width), from, to, owner);
+    }
+
+    firstStep = sf::Vector2i(m_pathScratch[1] % m_width, m_pathScratch[1] / m_width);
+    if (firstStep == start) ++m_waits;
+    return true;
+}
@@ -0,0 +1,94 @@
+#ifndef TANKS_RESERVATIONTABLE_H
+#define TANKS_RESERVATIONTABLE_H
+
+// =========================================================================
+// 必要的头文件包含
+// =========================================================================
+#include <SFML/Graphics.hpp> // sf::Vector2i
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class Map;
+class Tank;
+
+// =========================================================================
+// ReservationTable: 以地图瓦片为键的时空预留表 (WHCA* 风格的协同寻路)
+// =========================================================================
+// 时间以模拟tick计。每条预留表示“某坦克在 [from, to) 期间占用该格”；
+// 坦克从格子 A 走向 B 的那一步里同时占用 A 和 B，因此迎面互换位置也会被视为冲突。
+// 各坦克速度不同，每步的tick数由自身速度换算 (ticksPerStep)，时间轴对所有坦克一致。
+// 坦克重新规划时先释放自己之前的全部预留；已过期的预留在访问该格时顺便清除。
+class ReservationTable {
+public:
+    static constexpr int WINDOW_STEPS = 8; // 规划窗口 (步)：只为接下来这么多步做时空搜索与预留
+
+    ReservationTable();
+
+    void configure(int width, int height);                  // 设定地图尺寸 (同时清空)
+    void clear();
+    void beginTick(std::uint64_t tick, float secondsPerTick); // 每tick开始时设置当前时间
+    std::uint64_t getCurrentTick() const { return m_currentTick; }
+
+    // 以给定速度走完一格需要的tick数 (至少为1)
+    std::uint64_t ticksPerStep(float speedPixelsPerSecond, int tileSize) const;
+
+    bool isFree(sf::Vector2i tile, std::uint64_t from, std::uint64_t to, const Tank* owner) const;
+    void reserve(sf::Vector2i tile, std::uint64_t from, std::uint64_t to, const Tank* owner);
+    void release(const Tank* owner);      // 释放 owner 的全部预留
+    void releaseDestroyed();              // 释放已被摧毁坦克的预留 (须在释放坦克对象之前调用)
+
+    // 原地占用 tile 一个窗口的时间 (例如停下来打砖墙时)
+    void holdTile(const Tank* owner, sf::Vector2i tile, std::uint64_t ticksPerStep);
+
+    // 窗口化时空 A*：从 start 出发搜索 WINDOW_STEPS 步 (每步可移动到相邻可通行格或原地等待)，
+    // 代价 = 步数 + heuristic(窗口末端所在格)，并避开其他坦克的预留。
+    // 成功时释放旧预留、为整条窗口路径重新预留，并通过 firstStep 返回第一步 (等于 start 表示等待)。
+    bool planWindow(const Map& map, const Tank* owner, sf::Vector2i start, std::uint64_t ticksPerStep,
+                    const std::function<std::uint32_t(sf::Vector2i)>& heuristic, sf::Vector2i& firstStep);
+
+    // 统计 (性能对比用)
+    size_t getPlanCount() const { return m_plans; }
+    size_t getWaitCount() const { return m_waits; }           // 规划结果为原地等待的次数
+    size_t getExpansionCount() const { return m_expansions; }
+
+private:
+    struct Reservation {
+        std::uint64_t from;
+        std::uint64_t to;
+        const Tank* owner;
+    };
+
+    bool inBounds(sf::Vector2i tile) const { return tile.x >= 0 && tile.y >= 0 && tile.x < m_width && tile.y < m_height; }
+    void pruneExpired(std::vector<Reservation>& slots) const;
+
+    int m_width;
+    int m_height;
+    std::uint64_t m_currentTick;
+    float m_secondsPerTick;
+
+    std::unordered_map<int, std::vector<Reservation>> m_slots;          // 有预留的格子 -> 预留列表 (大地图上只为坦克附近的格子占内存)
+    std::unordered_map<const Tank*, std::vector<int>> m_ownerTiles;     // 每个坦克预留过的格子 (用于释放)
+
+    // planWindow 的搜索缓冲 (成员复用，避免每次分配)
+    struct Node {
+        std::uint32_t f;
+        std::uint32_t h;
+        std::uint64_t state; // 步数 * 格子总数 + 格子下标
+        bool operator>(const Node& other) const {
+            return f != other.f ? f > other.f : (h != other.h ? h > other.h : state > other.state);
+        }
+    };
+    std::vector<Node> m_open;
+    std::unordered_map<std::uint64_t, std::uint64_t> m_parent;          // 状态 -> 前驱状态
+    std::vector<int> m_pathScratch;
+
+    size_t m_plans;
+    size_t m_waits;
+    size_t m_expansions;
+};
+
+#endif //TANKS_RESERVATIONTABLE_H
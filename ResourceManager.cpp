@@ -0,0 +1,339 @@
+// ResourceManager.cpp
+#include "ResourceManager.h"
+#include "AssetPack.h"
+#include "Trace.h"
+#include <algorithm> // std::min, std::max
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>   // std::setprecision
+#include <thread>
+
+// =========================================================================
+// 配置与纹理加载
+// =========================================================================
+bool ResourceManager::loadConfig(const std::string& configPath, bool loadTextures) {
+    TRACE_SCOPE("ResourceManager::loadConfig");
+    std::ifstream configFile(configPath);
+    if (!configFile.is_open()) {
+        LOG_ERROR("CRITICAL ERROR: Failed to open config file: " << configPath);
+        return false;
+    }
+
+    try {
+        configFile >> m_configJson;
+        LOG_INFO("Config file '" << configPath << "' loaded and parsed successfully.");
+
+        if (loadTextures) {
+            loadAllTextures();
+            m_texturesLoaded = true;
+        } else {
+            LOG_INFO("Texture loading skipped (headless mode).");
+        }
+    } catch (nlohmann::json::parse_error& e) {
+        LOG_ERROR("CRITICAL ERROR: JSON parsing failed: " << e.what());
+        return false;
+    } catch (nlohmann::json::type_error& e) {
+        LOG_ERROR("CRITICAL ERROR: JSON type error: " << e.what());
+        return false;
+    } catch (const std::exception& e) {
+        LOG_ERROR("CRITICAL ERROR: An unexpected error occurred during config loading: " << e.what());
+        return false;
+    }
+    return true;
+}
+
+void ResourceManager::loadAllTextures() {
+    decodeIntoAtlas();
+
+    // 打包图集并上传 (GPU 上传只能在主线程按顺序进行)，然后解析所有子区域
+    auto uploadStart = std::chrono::steady_clock::now();
+    if (!m_atlas.build()) {
+        LOG_WARN("Warning: Texture atlas was built with errors; affected assets will not be drawn.");
+    }
+    const double uploadMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - uploadStart).count();
+    resolveRegions();
+
+    LOG_INFO("Atlas: " << m_atlas.getRegionCount() << " images packed into " << m_atlas.getPageCount()
+              << " page(s), " << m_atlas.getPageMemoryBytes() / 1024 << " KiB, built and uploaded in "
+              << std::fixed << std::setprecision(1) << uploadMillis << " ms" << std::defaultfloat);
+}
+
+void ResourceManager::decodeIntoAtlas() {
+    TRACE_SCOPE("ResourceManager::decodeIntoAtlas");
+    // 图集页尺寸 (texture_atlas.page_size)，build() 上传前再收紧到显卡支持的最大纹理尺寸；
+    // 解码线程数 (texture_atlas.decode_threads)，0 表示按CPU核数
+    unsigned pageSize = 2048;
+    unsigned decodeThreads = 0;
+    if (m_configJson.contains("texture_atlas")) {
+        pageSize = m_configJson["texture_atlas"].value("page_size", pageSize);
+        decodeThreads = m_configJson["texture_atlas"].value("decode_threads", decodeThreads);
+    }
+    m_atlas = TextureAtlas(pageSize);
+    m_textureIds.clear();
+    m_tankFrameIds.clear();
+
+    // 1. 按登记顺序收集所有图片 (地图瓦片最先：Map 用一个顶点数组绘制，需要所有瓦片位于同一页)
+    std::vector<PendingImage> images;
+    collectImageJobs(images);
+
+    // 2. 在工作线程上并行解码 (PNG 解码只涉及CPU与文件读取，互不依赖)
+    auto decodeStart = std::chrono::steady_clock::now();
+    const unsigned threadsUsed = decodeImages(images, decodeThreads);
+    const double decodeWallMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - decodeStart).count();
+
+    // 3. 主线程按原顺序登记到图集，并输出每个资源的解码耗时
+    double decodeTotalMillis = 0.0;
+    for (PendingImage& pending : images) {
+        decodeTotalMillis += pending.decodeMillis;
+        if (!pending.loaded) {
+            LOG_WARN("Warning: Failed to load " << pending.category << " texture '" << pending.name
+                      << "' from path: " << pending.path);
+            continue;
+        }
+        const int id = m_atlas.add(pending.image);
+        if (pending.tankType.empty()) {
+            m_textureIds[pending.name] = id;
+        } else {
+            m_tankFrameIds[pending.tankType][pending.direction].push_back(id);
+        }
+        LOG_INFO("Loaded " << pending.category << " texture: " << pending.name << " ("
+                  << pending.image.getSize().x << "x" << pending.image.getSize().y << ", decoded in "
+                  << std::fixed << std::setprecision(2) << pending.decodeMillis << " ms)");
+        pending.image = sf::Image(); // 图集已保存副本，尽早释放
+    }
+    LOG_INFO("Decoded " << images.size() << " images on " << threadsUsed << " thread(s) in "
+              << std::fixed << std::setprecision(1) << decodeWallMillis << " ms (" << decodeTotalMillis
+              << " ms summed per image)" << std::defaultfloat);
+}
+
+void ResourceManager::resolveRegions() {
+    // std::map 按名字排序遍历，编号与加载方式 (原始图片/资源包) 无关
+    m_registry.clear();
+    m_textureRegions.clear();
+    for (const auto& [key, id] : m_textureIds) {
+        const TextureHandle handle = m_registry.internTexture(key);
+        m_textureRegions.resize(static_cast<size_t>(handle) + 1);
+        m_textureRegions[static_cast<size_t>(handle)] = m_atlas.getRegion(id);
+    }
+    m_tankFrames.clear();
+    for (const auto& [tankType, directions] : m_tankFrameIds) {
+        const TankTypeHandle handle = m_registry.internTankType(tankType);
+        m_tankFrames.resize(static_cast<size_t>(handle) + 1);
+        for (const auto& [dir, frameIds] : directions) {
+            std::vector<TextureRegion>& frames = m_tankFrames[static_cast<size_t>(handle)][static_cast<size_t>(dir)];
+            for (int id : frameIds) frames.push_back(m_atlas.getRegion(id));
+        }
+    }
+}
+
+// =========================================================================
+// 资源包 (AssetPack)
+// =========================================================================
+bool ResourceManager::writePack(const std::string& packPath) {
+    if (m_configJson.is_null()) {
+        LOG_ERROR("ResourceManager::writePack() - Error: No configuration loaded.");
+        return false;
+    }
+    decodeIntoAtlas();
+    if (!m_atlas.pack()) {
+        LOG_WARN("Warning: Texture atlas was packed with errors; affected assets are left out of the pack.");
+    }
+
+    // 区域表：按登记顺序写出 (坦克帧的先后即帧号)；放不下的图片没有页，直接跳过
+    std::vector<AssetPackEntry> entries;
+    auto addEntry = [this, &entries](int id, const std::string& key, bool isTankFrame, Direction dir) {
+        if (m_atlas.getRegionPage(id) < 0) return;
+        AssetPackEntry entry;
+        entry.key = key;
+        entry.isTankFrame = isTankFrame;
+        entry.direction = dir;
+        entry.page = m_atlas.getRegionPage(id);
+        entry.rect = m_atlas.getRegionRect(id);
+        entries.push_back(entry);
+    };
+    for (const auto& [key, id] : m_textureIds) addEntry(id, key, false, Direction::UP);
+    for (const auto& [tankType, directions] : m_tankFrameIds) {
+        for (const auto& [dir, frameIds] : directions) {
+            for (int id : frameIds) addEntry(id, tankType, true, dir);
+        }
+    }
+
+    const std::vector<sf::Image>& pages = m_atlas.getPageImages();
+    const bool written = AssetPack::write(packPath, m_configJson.dump(), pages, entries);
+    if (written) {
+        size_t pixelBytes = 0;
+        for (const sf::Image& page : pages) pixelBytes += static_cast<size_t>(page.getSize().x) * page.getSize().y * 4;
+        LOG_INFO("Asset pack '" << packPath << "' written: " << entries.size() << " regions on "
+                  << pages.size() << " page(s), " << pixelBytes / 1024 << " KiB of pixels.");
+    }
+    m_atlas.clear(); // 资源包生成器不上传纹理
+    m_textureIds.clear();
+    m_tankFrameIds.clear();
+    return written;
+}
+
+bool ResourceManager::loadPack(const std::string& packPath, bool loadTextures) {
+    TRACE_SCOPE("ResourceManager::loadPack");
+    auto start = std::chrono::steady_clock::now();
+    AssetPack pack;
+    if (!pack.open(packPath)) return false;
+
+    try {
+        const std::string_view configText = pack.getConfigText();
+        m_configJson = nlohmann::json::parse(configText.begin(), configText.end());
+    } catch (const std::exception& e) {
+        LOG_ERROR("CRITICAL ERROR: Config embedded in asset pack '" << packPath << "' failed to parse: " << e.what());
+        return false;
+    }
+    LOG_INFO("Config loaded from asset pack '" << packPath << "'.");
+    if (!loadTextures) {
+        LOG_INFO("Texture loading skipped (headless mode).");
+        return true;
+    }
+
+    // 页像素直接从映射内存上传，区域按包内顺序登记 (与生成时的登记顺序一致)
+    m_atlas = TextureAtlas();
+    m_textureIds.clear();
+    m_tankFrameIds.clear();
+    std::vector<int> atlasPages;
+    for (const AssetPackPage& page : pack.getPages()) {
+        atlasPages.push_back(m_atlas.addPage(page.width, page.height, page.pixels));
+    }
+    for (const AssetPackEntry& entry : pack.getEntries()) {
+        const int id = m_atlas.addRegion(atlasPages[static_cast<size_t>(entry.page)], entry.rect);
+        if (entry.isTankFrame) {
+            m_tankFrameIds[entry.key][entry.direction].push_back(id);
+        } else {
+            m_textureIds[entry.key] = id;
+        }
+    }
+    resolveRegions();
+    m_texturesLoaded = true;
+
+    const double loadMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    LOG_INFO("Asset pack: " << pack.getEntries().size() << " regions on " << m_atlas.getPageCount() << " page(s), "
+              << pack.getFileSize() / 1024 << " KiB mapped, loaded and uploaded in "
+              << std::fixed << std::setprecision(1) << loadMillis << " ms" << std::defaultfloat);
+    return true;
+}
+
+void ResourceManager::collectImageJobs(std::vector<PendingImage>& images) const {
+    auto addImage = [&images](const char* category, const std::string& name, const std::string& path) -> PendingImage& {
+        images.emplace_back();
+        images.back().category = category;
+        images.back().name = name;
+        images.back().path = path;
+        return images.back();
+    };
+    if (!m_configJson.contains("textures")) {
+        LOG_WARN("Warning: 'textures' not found in config.");
+        return;
+    }
+    const auto& textures = m_configJson["textures"];
+
+    // --- 地图瓦片纹理 ---
+    if (textures.contains("map_tiles")) {
+        for (auto& [key, pathNode] : textures["map_tiles"].items()) {
+            if (pathNode.is_string()) addImage("map_tile", "map_" + key, pathNode.get<std::string>()); // 给地图瓦片键名加上 "map_" 前缀
+        }
+    } else { LOG_WARN("Warning: 'textures.map_tiles' not found in config.");}
+
+    // --- 道具纹理 ---
+    if (textures.contains("props")) {
+        for (auto& [key, pathNode] : textures["props"].items()) {
+            if (pathNode.is_string()) addImage("prop", key, pathNode.get<std::string>());
+        }
+    } else { LOG_WARN("Warning: 'textures.props' not found in config.");}
+
+    // --- 坦克纹理 (支持多帧动画；单帧纹理与多帧动画统一按路径列表处理) ---
+    if (textures.contains("tanks")) {
+        for (auto& [tankType, directionsNode] : textures["tanks"].items()) {
+            for (auto& [dirStr, pathsNode] : directionsNode.items()) {
+                Direction dirEnum;
+                if (dirStr == "up") dirEnum = Direction::UP;
+                else if (dirStr == "down") dirEnum = Direction::DOWN;
+                else if (dirStr == "left") dirEnum = Direction::LEFT;
+                else if (dirStr == "right") dirEnum = Direction::RIGHT;
+                else {
+                    LOG_WARN("Warning: Unknown direction string '" << dirStr << "' for tank type '" << tankType << "'");
+                    continue;
+                }
+
+                std::vector<std::string> framePaths;
+                if (pathsNode.is_array()) { // 多帧动画
+                    for (const auto& pathNodeFrame : pathsNode) {
+                        if (pathNodeFrame.is_string()) framePaths.push_back(pathNodeFrame.get<std::string>());
+                    }
+                } else if (pathsNode.is_string()) { // 单帧纹理
+                    framePaths.push_back(pathsNode.get<std::string>());
+                }
+                for (size_t frame = 0; frame < framePaths.size(); ++frame) {
+                    PendingImage& pending = addImage("tank", tankType + "/" + dirStr + "/" + std::to_string(frame), framePaths[frame]);
+                    pending.tankType = tankType;
+                    pending.direction = dirEnum;
+                }
+            }
+        }
+    } else { LOG_WARN("Warning: 'textures.tanks' not found in config.");}
+
+    // --- 子弹纹理 ---
+    if (textures.contains("bullets")) {
+        for (auto& [dirStr, pathNode] : textures["bullets"].items()) {
+            if (pathNode.is_string()) addImage("bullet", "bullet_" + dirStr, pathNode.get<std::string>()); // 例如: "bullet_up"
+        }
+    } else { LOG_WARN("Warning: 'textures.bullets' not found in config.");}
+}
+
+unsigned ResourceManager::decodeImages(std::vector<PendingImage>& images, unsigned threadCount) {
+    if (images.empty()) return 0;
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    threadCount = std::min<unsigned>(threadCount, static_cast<unsigned>(images.size()));
+
+    // 工作线程从共享下标依次领取任务；每张图片只写自己的槽位，无需加锁
+    std::atomic<size_t> nextImage{0};
+    auto worker = [&images, &nextImage]() {
+        for (size_t i = nextImage.fetch_add(1); i < images.size(); i = nextImage.fetch_add(1)) {
+            TRACE_SCOPE("decode_image");
+            PendingImage& pending = images[i];
+            auto start = std::chrono::steady_clock::now();
+            pending.loaded = pending.image.loadFromFile(pending.path);
+            pending.decodeMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (unsigned t = 1; t < threadCount; ++t) {
+        threads.emplace_back([&worker]() {
+            TraceRecorder::instance().setThreadName("decode worker");
+            worker();
+        });
+    }
+    worker(); // 主线程同样参与解码
+    for (std::thread& thread : threads) thread.join();
+    return threadCount;
+}
+
+// =========================================================================
+// 资源访问
+// =========================================================================
+const TextureRegion& ResourceManager::getTexture(TextureHandle handle) const {
+    static const TextureRegion emptyTexture; // 静态空区域，避免每次都创建
+    if (handle < 0 || static_cast<size_t>(handle) >= m_textureRegions.size()) return emptyTexture;
+    return m_textureRegions[static_cast<size_t>(handle)];
+}
+
+const std::vector<TextureRegion>& ResourceManager::getTankTextures(TankTypeHandle tankType, Direction dir) const {
+    static const std::vector<TextureRegion> emptyTankTextures; // 静态空列表
+    if (tankType < 0 || static_cast<size_t>(tankType) >= m_tankFrames.size()) return emptyTankTextures;
+    return m_tankFrames[static_cast<size_t>(tankType)][static_cast<size_t>(dir)];
+}
+
+const TextureRegion& ResourceManager::getTexture(const std::string& key) const {
+    const TextureHandle handle = m_registry.findTexture(key);
+    if (handle == INVALID_ASSET_HANDLE) {
+        LOG_ERROR("ResourceManager::getTexture() Error: Texture with key '" << key << "' not found in cache. Returning empty texture.");
+    }
+    return getTexture(handle);
+}
@@ -0,0 +1,86 @@
+#ifndef TANKS_RESOURCEMANAGER_H
+#define TANKS_RESOURCEMANAGER_H
+
+// =========================================================================
+// 必要的头文件包含
+// =========================================================================
+#include "heads.h"      // 项目通用头文件 (SFML, iostream, json, etc.)
+#include "common.h"     // 通用定义 (如 Direction 枚举)
+#include "TextureAtlas.h" // 加载时打包的纹理图集
+#include "AssetRegistry.h" // 纹理键名/坦克类型 -> 稠密编号
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+
+// =========================================================================
+// ResourceManager: 配置与纹理资源的统一持有者
+// =========================================================================
+// 从 Game 中拆分出来，使得模拟层 (World) 可以只读取配置而不加载任何纹理。
+// 无界面运行 (headless) 时以 loadTextures = false 调用 loadConfig，
+// 只解析 JSON，不创建任何 sf::Texture。
+// 所有图片 (道具、地图瓦片、坦克动画帧、子弹) 在启动时打包进少数几张图集页，
+// 每个资源以 TextureRegion (页纹理 + 子矩形) 的形式提供；地图瓦片最先打包，保证位于同一页。
+// 发布时可用 TanksPackBuilder 把配置与打包好的图集页烘焙成一个资源包 (AssetPack)，
+// 游戏启动时 loadPack() 以内存映射打开并直接上传，不再读取图片路径或解码 PNG。
+// 加载完成后所有纹理键名与坦克类型都被登记为稠密编号 (AssetRegistry)；
+// 实体在创建时解析一次编号，之后按编号直接索引，不再做字符串查找。
+class ResourceManager {
+public:
+    ResourceManager() = default;
+
+    // 解析配置文件；loadTextures 为 false 时跳过所有图片加载
+    bool loadConfig(const std::string& configPath, bool loadTextures = true);
+    // 从资源包读取配置与图集页；loadTextures 为 false 时只解析其中的配置
+    bool loadPack(const std::string& packPath, bool loadTextures = true);
+    // 在 loadConfig(path, false) 之后调用：解码所有图片、在CPU上打包图集并写出资源包
+    bool writePack(const std::string& packPath);
+
+    const nlohmann::json& getConfig() const { return m_configJson; }
+    bool hasTextures() const { return m_texturesLoaded; }
+
+    // =========================================================================
+    // 资源访问
+    // =========================================================================
+    // 按编号访问 (热路径)；无效编号返回空区域/空列表
+    const TextureRegion& getTexture(TextureHandle handle) const;
+    const std::vector<TextureRegion>& getTankTextures(TankTypeHandle tankType, Direction dir) const;
+    // 按名字访问 (仅加载/初始化时使用)；找不到时打印错误并返回空区域
+    const TextureRegion& getTexture(const std::string& key) const;
+    TextureHandle findTexture(const std::string& key) const { return m_registry.findTexture(key); }
+    TankTypeHandle findTankType(const std::string& tankType) const { return m_registry.findTankType(tankType); }
+    const AssetRegistry& getRegistry() const { return m_registry; }
+    const TextureAtlas& getAtlas() const { return m_atlas; }
+
+private:
+    // 启动时待解码的一张图片 (普通纹理或坦克动画帧)
+    struct PendingImage {
+        std::string category;   // 日志用: map_tile / prop / tank / bullet
+        std::string name;       // 纹理键名 (坦克帧为 类型/方向/帧号，仅用于日志)
+        std::string path;
+        std::string tankType;   // 非空表示坦克动画帧
+        Direction direction = Direction::UP;
+        sf::Image image;
+        bool loaded = false;
+        double decodeMillis = 0.0;
+    };
+
+    void loadAllTextures();
+    void decodeIntoAtlas();  // 读取图集配置，解码所有图片并按顺序登记到 m_atlas (尚未打包)
+    void resolveRegions();   // 图集可用后，登记所有名字并把区域编号解析为按编号索引的 TextureRegion 表
+    void collectImageJobs(std::vector<PendingImage>& images) const; // 按图集登记顺序列出所有图片
+    // 在线程池上并行解码 (threadCount 为0时按CPU核数)，返回实际使用的线程数
+    static unsigned decodeImages(std::vector<PendingImage>& images, unsigned threadCount);
+
+    nlohmann::json m_configJson;
+    bool m_texturesLoaded = false;
+    TextureAtlas m_atlas;
+    std::map<std::string, int> m_textureIds;                                   // 键名 -> 图集区域编号
+    std::map<std::string, std::map<Direction, std::vector<int>>> m_tankFrameIds; // 坦克动画帧的区域编号
+    // 打包完成后解析出的子区域 (TextureRegion 只含指针与矩形，按值保存)，下标即编号
+    AssetRegistry m_registry;
+    std::vector<TextureRegion> m_textureRegions;                           // TextureHandle -> 子区域
+    std::vector<std::array<std::vector<TextureRegion>, 4>> m_tankFrames;   // TankTypeHandle -> 按 Direction 枚举顺序的动画帧
+};
+
+#endif //TANKS_RESOURCEMANAGER_H
@@ -10,9 +10,9 @@
 
 class SlowDownAI:public Tools {
 public:
-    SlowDownAI(sf::Vector2f pos, const sf::Texture &texture);
+    SlowDownAI(sf::Vector2f pos, const TextureRegion &texture);
 
-    void applyEffect(Tank &tank,Game& gameContext) override;
+    void applyEffect(Tank &tank,World& worldContext) override;
 
 };
 
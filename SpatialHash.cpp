@@ -0,0 +1,98 @@
+// SpatialHash.cpp
+#include "SpatialHash.h"
+#include <algorithm> // std::min, std::max, std::fill
+
+// =========================================================================
+// 构造与配置
+// =========================================================================
+SpatialHash::SpatialHash()
+        : m_cellWidth(50.f), m_cellHeight(50.f),
+          m_columns(1), m_rows(1),
+          m_queryStamp(0) {
+    m_cellStart.assign(2, 0);
+}
+
+void SpatialHash::configure(float cellWidth, float cellHeight, int columns, int rows) {
+    m_cellWidth = cellWidth > 0.f ? cellWidth : 50.f;
+    m_cellHeight = cellHeight > 0.f ? cellHeight : 50.f;
+    m_columns = std::max(1, columns);
+    m_rows = std::max(1, rows);
+    m_cellStart.assign(static_cast<size_t>(m_columns) * m_rows + 1, 0);
+    m_cellEntries.clear();
+    m_pending.clear();
+}
+
+// =========================================================================
+// 构建
+// =========================================================================
+void SpatialHash::clear() {
+    m_pending.clear();
+}
+
+void SpatialHash::insert(int id, const sf::FloatRect& bounds) {
+    if (id < 0) return;
+    PendingEntry entry{id, 0, 0, 0, 0};
+    cellRange(bounds, entry.minX, entry.minY, entry.maxX, entry.maxY);
+    m_pending.push_back(entry);
+    if (static_cast<size_t>(id) >= m_seenStamp.size()) {
+        m_seenStamp.resize(static_cast<size_t>(id) + 1, 0);
+    }
+}
+
+void SpatialHash::build() {
+    // 计数排序：先统计每个格子的条目数，再前缀和得到起始位置，最后填入
+    std::fill(m_cellStart.begin(), m_cellStart.end(), 0);
+    for (const PendingEntry& e : m_pending) {
+        for (int y = e.minY; y <= e.maxY; ++y) {
+            for (int x = e.minX; x <= e.maxX; ++x) {
+                ++m_cellStart[static_cast<size_t>(y) * m_columns + x + 1];
+            }
+        }
+    }
+    for (size_t i = 1; i < m_cellStart.size(); ++i) {
+        m_cellStart[i] += m_cellStart[i - 1];
+    }
+
+    m_cellEntries.resize(static_cast<size_t>(m_cellStart.back()));
+    m_cellCursor.assign(m_cellStart.begin(), m_cellStart.end() - 1); // 容量保留，稳定状态下不再分配
+    for (const PendingEntry& e : m_pending) {
+        for (int y = e.minY; y <= e.maxY; ++y) {
+            for (int x = e.minX; x <= e.maxX; ++x) {
+                m_cellEntries[static_cast<size_t>(m_cellCursor[static_cast<size_t>(y) * m_columns + x]++)] = e.id;
+            }
+        }
+    }
+}
+
+// =========================================================================
+// 查询
+// =========================================================================
+void SpatialHash::query(const sf::FloatRect& area, std::vector<int>& out) const {
+    out.clear();
+    if (++m_queryStamp == 0) { // 计数器回绕时清空标记
+        std::fill(m_seenStamp.begin(), m_seenStamp.end(), 0);
+        m_queryStamp = 1;
+    }
+
+    int minX, minY, maxX, maxY;
+    cellRange(area, minX, minY, maxX, maxY);
+    for (int y = minY; y <= maxY; ++y) {
+        for (int x = minX; x <= maxX; ++x) {
+            size_t cell = static_cast<size_t>(y) * m_columns + x;
+            for (int i = m_cellStart[cell]; i < m_cellStart[cell + 1]; ++i) {
+                int id = m_cellEntries[static_cast<size_t>(i)];
+                if (m_seenStamp[static_cast<size_t>(id)] != m_queryStamp) {
+                    m_seenStamp[static_cast<size_t>(id)] = m_queryStamp;
+                    out.push_back(id);
+                }
+            }
+        }
+    }
+}
+
+void SpatialHash::cellRange(const sf::FloatRect& bounds, int& minX, int& minY, int& maxX, int& maxY) const {
+    minX = std::clamp(static_cast<int>(bounds.left / m_cellWidth), 0, m_columns - 1);
+    minY = std::clamp(static_cast<int>(bounds.top / m_cellHeight), 0, m_rows - 1);
+    maxX = std::clamp(static_cast<int>((bounds.left + bounds.width) / m_cellWidth), 0, m_columns - 1);
+    maxY = std::clamp(static_cast<int>((bounds.top + bounds.height) / m_cellHeight), 0, m_rows - 1);
+}
@@ -0,0 +1,63 @@
+#ifndef TANKS_SPATIALHASH_H
+#define TANKS_SPATIALHASH_H
+
+// =========================================================================
+// 必要的头文件包含
+// =========================================================================
+#include <SFML/Graphics.hpp> // sf::FloatRect
+#include <vector>
+
+// =========================================================================
+// SpatialHash: 均匀网格空间哈希 (用于宽相碰撞检测)
+// =========================================================================
+// 每个tick重建：clear() -> 多次 insert() -> build()。
+// 单元格尺寸通常等于地图瓦片尺寸；跨越多个单元格的对象会登记到每个覆盖的格子。
+// build() 用计数排序把条目压成连续数组 (每个格子一段)，查询时只遍历覆盖到的格子。
+// 地图外的坐标被夹到边缘格子，因此越界对象不会丢失。
+class SpatialHash {
+public:
+    SpatialHash();
+
+    // 设置网格：单元格尺寸 (像素) 与行列数 (格子数)。尺寸变化时才需要调用
+    void configure(float cellWidth, float cellHeight, int columns, int rows);
+
+    // =========================================================================
+    // 构建
+    // =========================================================================
+    void clear();                                    // 清空所有条目
+    void insert(int id, const sf::FloatRect& bounds); // 登记对象 (id 需为非负、较小的整数，例如容器下标)
+    void build();                                    // 完成本轮登记，生成查询用的紧凑数组
+
+    // =========================================================================
+    // 查询
+    // =========================================================================
+    // 返回与 area 覆盖的格子中登记过的所有 id (去重，不做精确的矩形相交测试)
+    void query(const sf::FloatRect& area, std::vector<int>& out) const;
+
+    int getColumns() const { return m_columns; }
+    int getRows() const { return m_rows; }
+
+private:
+    struct PendingEntry {
+        int id;
+        int minX, minY, maxX, maxY; // 覆盖的格子范围 (含端点)
+    };
+
+    void cellRange(const sf::FloatRect& bounds, int& minX, int& minY, int& maxX, int& maxY) const;
+
+    float m_cellWidth;
+    float m_cellHeight;
+    int m_columns;
+    int m_rows;
+
+    std::vector<PendingEntry> m_pending;  // 本轮 insert 的对象
+    std::vector<int> m_cellStart;         // 每个格子在 m_cellEntries 中的起始位置 (长度 = 格子数 + 1)
+    std::vector<int> m_cellEntries;       // 按格子排列的 id
+    std::vector<int> m_cellCursor;        // build 填入时每个格子的写入位置 (跨 build 复用，避免每次分配)
+
+    // 查询去重：每个 id 记录最后一次被收集的查询编号
+    mutable std::vector<unsigned int> m_seenStamp;
+    mutable unsigned int m_queryStamp;
+};
+
+#endif //TANKS_SPATIALHASH_H
@@ -0,0 +1,57 @@
+// SpriteBatch.cpp
+#include "SpriteBatch.h"
+#include <cstdlib> // std::abs
+
+std::vector<sf::Vertex>& SpriteBatch::verticesFor(const sf::Texture* texture) {
+    for (PageBatch& page : m_pages) {
+        if (page.texture == texture) return page.vertices;
+    }
+    m_pages.emplace_back();
+    m_pages.back().texture = texture;
+    return m_pages.back().vertices;
+}
+
+void SpriteBatch::add(const sf::Sprite& sprite) {
+    const sf::Texture* texture = sprite.getTexture();
+    if (!texture) return;
+    // 与 sf::Sprite 自身的顶点一致：局部尺寸取子矩形宽高的绝对值，纹理坐标允许翻转
+    const sf::IntRect& rect = sprite.getTextureRect();
+    const float width = static_cast<float>(std::abs(rect.width));
+    const float height = static_cast<float>(std::abs(rect.height));
+    const float left = static_cast<float>(rect.left);
+    const float right = left + static_cast<float>(rect.width);
+    const float top = static_cast<float>(rect.top);
+    const float bottom = top + static_cast<float>(rect.height);
+    const sf::Transform& transform = sprite.getTransform();
+    const sf::Color& color = sprite.getColor();
+
+    std::vector<sf::Vertex>& vertices = verticesFor(texture);
+    vertices.emplace_back(transform.transformPoint(sf::Vector2f(0.f, 0.f)), color, sf::Vector2f(left, top));
+    vertices.emplace_back(transform.transformPoint(sf::Vector2f(width, 0.f)), color, sf::Vector2f(right, top));
+    vertices.emplace_back(transform.transformPoint(sf::Vector2f(width, height)), color, sf::Vector2f(right, bottom));
+    vertices.emplace_back(transform.transformPoint(sf::Vector2f(0.f, height)), color, sf::Vector2f(left, bottom));
+}
+
+void SpriteBatch::add(const TextureRegion& region, sf::Vector2f position, sf::Vector2f origin) {
+    if (!region.isValid()) return;
+    const sf::IntRect& rect = region.rect;
+    const sf::Vector2f topLeft = position - origin;
+    const sf::Vector2f size(static_cast<float>(rect.width), static_cast<float>(rect.height));
+    const sf::Vector2f texTopLeft(static_cast<float>(rect.left), static_cast<float>(rect.top));
+
+    std::vector<sf::Vertex>& vertices = verticesFor(region.texture);
+    vertices.emplace_back(topLeft, sf::Color::White, texTopLeft);
+    vertices.emplace_back(sf::Vector2f(topLeft.x + size.x, topLeft.y), sf::Color::White, sf::Vector2f(texTopLeft.x + size.x, texTopLeft.y));
+    vertices.emplace_back(topLeft + size, sf::Color::White, texTopLeft + size);
+    vertices.emplace_back(sf::Vector2f(topLeft.x, topLeft.y + size.y), sf::Color::White, sf::Vector2f(texTopLeft.x, texTopLeft.y + size.y));
+}
+
+void SpriteBatch::flush(sf::RenderTarget& target) {
+    for (PageBatch& page : m_pages) {
+        if (page.vertices.empty()) continue;
+        target.draw(page.vertices.data(), page.vertices.size(), sf::Quads, sf::RenderStates(page.texture));
+        ++m_drawCalls;
+        m_quads += page.vertices.size() / 4;
+        page.vertices.clear();
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef TANKS_SPRITEBATCH_H
+#define TANKS_SPRITEBATCH_H
+
+// =========================================================================
+// 必要的头文件包含
+// =========================================================================
+#include <SFML/Graphics.hpp> // sf::Vertex, sf::Sprite, sf::RenderTarget
+#include "TextureAtlas.h"    // TextureRegion
+#include <cstddef>
+#include <vector>
+
+// =========================================================================
+// SpriteBatch: 把同一图层的精灵合并成少量绘制调用
+// =========================================================================
+// add() 只把四个顶点追加到对应图集页的顶点缓冲，flush() 时每页用一次 draw 提交 (sf::Quads)。
+// 所有动态实体的纹理都来自少数几张图集页，因此一个图层通常只需要一次绘制调用。
+// 同一页内保持添加顺序；不同页之间按页首次出现的顺序绘制 (同一图层内的实体互不遮挡，顺序无关紧要)。
+// 顶点缓冲在帧之间复用，稳定运行后不再分配内存。
+class SpriteBatch {
+public:
+    void add(const sf::Sprite& sprite);  // 按精灵当前的纹理、子矩形、变换与颜色追加一个四边形
+    void add(const TextureRegion& region, sf::Vector2f position, sf::Vector2f origin); // 无旋转/缩放的快速路径
+    void flush(sf::RenderTarget& target); // 提交并清空所有页的顶点 (保留容量)
+
+    // 统计 (自上次 resetStats() 以来)
+    void resetStats() { m_drawCalls = 0; m_quads = 0; }
+    size_t getDrawCallCount() const { return m_drawCalls; }
+    size_t getQuadCount() const { return m_quads; }
+
+private:
+    std::vector<sf::Vertex>& verticesFor(const sf::Texture* texture);
+
+    struct PageBatch {
+        const sf::Texture* texture = nullptr;
+        std::vector<sf::Vertex> vertices;
+    };
+    std::vector<PageBatch> m_pages; // 页数很少，线性查找即可
+    size_t m_drawCalls = 0;
+    size_t m_quads = 0;
+};
+
+#endif //TANKS_SPRITEBATCH_H
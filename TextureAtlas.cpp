@@ -0,0 +1,165 @@
+// TextureAtlas.cpp
+#include "TextureAtlas.h"
+#include "Log.h"
+#include <algorithm> // std::min, std::max
+
+void TextureRegion::applyTo(sf::Sprite& sprite) const {
+    if (!isValid()) return;
+    sprite.setTexture(*texture);
+    sprite.setTextureRect(rect);
+}
+
+TextureAtlas::TextureAtlas(unsigned maxPageSize)
+        : m_pageSize(std::max(maxPageSize, 64u)) { // 不在此查询显卡上限：无界面工具没有图形上下文
+}
+
+int TextureAtlas::add(const sf::Image& image) {
+    m_images.push_back(image);
+    m_regions.emplace_back();
+    m_regionPages.push_back(-1);
+    return static_cast<int>(m_regions.size() - 1);
+}
+
+void TextureAtlas::clear() {
+    m_images.clear();
+    m_pageImages.clear();
+    m_regions.clear();
+    m_regionPages.clear();
+    m_pages.clear();
+}
+
+const TextureRegion& TextureAtlas::getRegion(int id) const {
+    static const TextureRegion emptyRegion;
+    if (id < 0 || static_cast<size_t>(id) >= m_regions.size()) return emptyRegion;
+    return m_regions[static_cast<size_t>(id)];
+}
+
+int TextureAtlas::getRegionPage(int id) const {
+    if (id < 0 || static_cast<size_t>(id) >= m_regionPages.size()) return -1;
+    return m_regionPages[static_cast<size_t>(id)];
+}
+
+sf::IntRect TextureAtlas::getRegionRect(int id) const {
+    if (id < 0 || static_cast<size_t>(id) >= m_regions.size()) return sf::IntRect();
+    return m_regions[static_cast<size_t>(id)].rect;
+}
+
+// =========================================================================
+// 打包与上传
+// =========================================================================
+bool TextureAtlas::build() {
+    m_pageSize = std::min(m_pageSize, sf::Texture::getMaximumSize()); // 马上要上传，页不能超过显卡支持的最大纹理尺寸
+    const bool packed = pack();
+    const bool uploaded = upload(); // 即使个别图片放不下，其余图片照常可用
+    return packed && uploaded;
+}
+
+bool TextureAtlas::pack() {
+    m_pageImages.clear();
+
+    // 第一遍：只计算摆放位置 (行式装箱)，同时记下每页实际用到的宽高
+    std::vector<sf::Vector2u> pageExtents;
+    unsigned cursorX = 0, shelfY = 0, shelfHeight = 0;
+    bool ok = true;
+
+    for (size_t i = 0; i < m_images.size(); ++i) {
+        const sf::Vector2u size = m_images[i].getSize();
+        if (size.x == 0 || size.y == 0) continue;
+        if (size.x > m_pageSize || size.y > m_pageSize) {
+            LOG_ERROR("TextureAtlas::pack() - Error: Image " << i << " (" << size.x << "x" << size.y
+                      << ") exceeds the atlas page size " << m_pageSize << ".");
+            ok = false;
+            continue;
+        }
+        if (pageExtents.empty()) pageExtents.emplace_back(0, 0);
+        if (cursorX + size.x > m_pageSize) { // 换行
+            cursorX = 0;
+            shelfY += shelfHeight + PADDING;
+            shelfHeight = 0;
+        }
+        if (shelfY + size.y > m_pageSize) {  // 换页
+            pageExtents.emplace_back(0, 0);
+            cursorX = 0;
+            shelfY = 0;
+            shelfHeight = 0;
+        }
+        m_regionPages[i] = static_cast<int>(pageExtents.size() - 1);
+        m_regions[i].rect = sf::IntRect(static_cast<int>(cursorX), static_cast<int>(shelfY),
+                                        static_cast<int>(size.x), static_cast<int>(size.y));
+        sf::Vector2u& extent = pageExtents.back();
+        extent.x = std::max(extent.x, cursorX + size.x);
+        extent.y = std::max(extent.y, shelfY + size.y);
+        cursorX += size.x + PADDING;
+        shelfHeight = std::max(shelfHeight, size.y);
+    }
+
+    // 第二遍：每页拼成一张 sf::Image (只取实际用到的范围)
+    m_pageImages.resize(pageExtents.size());
+    for (size_t page = 0; page < pageExtents.size(); ++page) {
+        m_pageImages[page].create(pageExtents[page].x, pageExtents[page].y, sf::Color::Transparent);
+    }
+    for (size_t i = 0; i < m_images.size(); ++i) {
+        if (m_regionPages[i] < 0) continue;
+        const sf::IntRect& rect = m_regions[i].rect;
+        m_pageImages[static_cast<size_t>(m_regionPages[i])].copy(m_images[i], static_cast<unsigned>(rect.left), static_cast<unsigned>(rect.top));
+    }
+
+    m_images.clear(); // 像素已拼入页图片，单张图片不再需要
+    m_images.shrink_to_fit();
+    return ok;
+}
+
+bool TextureAtlas::upload() {
+    bool ok = true;
+    m_pages.clear();
+    for (size_t page = 0; page < m_pageImages.size(); ++page) {
+        auto texture = std::make_unique<sf::Texture>();
+        if (!texture->loadFromImage(m_pageImages[page])) {
+            LOG_ERROR("TextureAtlas::upload() - Error: Failed to create atlas page " << page << " ("
+                      << m_pageImages[page].getSize().x << "x" << m_pageImages[page].getSize().y << ").");
+            ok = false;
+        }
+        m_pages.push_back(std::move(texture));
+    }
+    for (size_t i = 0; i < m_regions.size(); ++i) {
+        if (m_regionPages[i] >= 0) m_regions[i].texture = m_pages[static_cast<size_t>(m_regionPages[i])].get();
+    }
+    m_pageImages.clear(); // 像素已上传，CPU 侧副本不再需要
+    return ok;
+}
+
+int TextureAtlas::addPage(unsigned width, unsigned height, const std::uint8_t* pixels) {
+    const unsigned maxSize = sf::Texture::getMaximumSize();
+    if (width > maxSize || height > maxSize) {
+        LOG_ERROR("TextureAtlas::addPage() - Error: Atlas page " << width << "x" << height << " exceeds the maximum texture size "
+                  << maxSize << " (rebuild the asset pack with a smaller texture_atlas.page_size).");
+        return -1;
+    }
+    auto texture = std::make_unique<sf::Texture>();
+    if (width == 0 || height == 0 || !texture->create(width, height)) {
+        LOG_ERROR("TextureAtlas::addPage() - Error: Failed to create atlas page (" << width << "x" << height << ").");
+        return -1;
+    }
+    texture->update(pixels); // 直接从调用方的内存 (例如资源包映射) 上传，不经过 sf::Image
+    m_pages.push_back(std::move(texture));
+    return static_cast<int>(m_pages.size() - 1);
+}
+
+int TextureAtlas::addRegion(int page, const sf::IntRect& rect) {
+    TextureRegion region;
+    if (page >= 0 && static_cast<size_t>(page) < m_pages.size()) {
+        region.texture = m_pages[static_cast<size_t>(page)].get();
+        region.rect = rect;
+    }
+    m_regions.push_back(region);
+    m_regionPages.push_back(region.texture ? page : -1);
+    return static_cast<int>(m_regions.size() - 1);
+}
+
+size_t TextureAtlas::getPageMemoryBytes() const {
+    size_t bytes = 0;
+    for (const auto& page : m_pages) {
+        bytes += static_cast<size_t>(page->getSize().x) * page->getSize().y * 4;
+    }
+    return bytes;
+}
@@ -0,0 +1,73 @@
+#ifndef TANKS_TEXTUREATLAS_H
+#define TANKS_TEXTUREATLAS_H
+
+// =========================================================================
+// 必要的头文件包含
+// =========================================================================
+#include <SFML/Graphics.hpp> // sf::Texture, sf::Image, sf::IntRect
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// =========================================================================
+// TextureRegion: 图集中的一块子区域 (某一页纹理 + 像素矩形)
+// =========================================================================
+// 无界面模式或图片加载失败时 texture 为空，isValid() 返回 false。
+struct TextureRegion {
+    const sf::Texture* texture = nullptr;
+    sf::IntRect rect;
+
+    bool isValid() const { return texture != nullptr && rect.width > 0 && rect.height > 0; }
+    sf::Vector2u getSize() const {
+        return isValid() ? sf::Vector2u(static_cast<unsigned>(rect.width), static_cast<unsigned>(rect.height)) : sf::Vector2u(0, 0);
+    }
+    void applyTo(sf::Sprite& sprite) const; // 设置精灵的纹理与子矩形 (无效区域时不做任何事)
+};
+
+// =========================================================================
+// TextureAtlas: 加载时把许多小图片打包进少数几张大纹理 (页)
+// =========================================================================
+// 用法：add() 登记所有图片 -> build() 一次性打包并上传 -> getRegion() 取子区域。
+// build() = pack() (只在CPU上摆放并拼出页图片) + upload() (创建页纹理)；
+// 资源包生成器只调用 pack() 并把页图片写入资源包，游戏启动时再用 addPage()/addRegion() 直接还原。
+// 按登记顺序逐行 (shelf) 摆放，一页放不下时换新页；先登记的图片一定在靠前的页里，
+// 因此需要同页绘制的一组图片 (例如地图瓦片) 应最先登记。
+// 图片之间留 PADDING 像素透明间隔，避免相邻区域在缩放采样时互相渗色。
+class TextureAtlas {
+public:
+    static const unsigned PADDING = 1;
+
+    explicit TextureAtlas(unsigned maxPageSize = 2048); // 不访问图形上下文；build() 时再按显卡上限收紧
+
+    int add(const sf::Image& image); // 登记一张图片，返回区域编号 (build 之后用于 getRegion)
+    bool build();                    // pack() + upload()
+    bool pack();                     // 计算摆放位置并拼出页图片 (不需要图形上下文)；登记的图片随后被释放
+    bool upload();                   // 把页图片上传为纹理，所有区域随即可用
+    void clear();
+
+    // pack() 之后、upload() 之前：页图片与各区域所在的页/矩形 (资源包生成器使用)
+    const std::vector<sf::Image>& getPageImages() const { return m_pageImages; }
+    int getRegionPage(int id) const;
+    sf::IntRect getRegionRect(int id) const;
+
+    // 从现成的页像素 (RGBA，例如资源包的内存映射) 直接还原图集
+    int addPage(unsigned width, unsigned height, const std::uint8_t* pixels); // 返回页下标，失败时返回 -1
+    int addRegion(int page, const sf::IntRect& rect);                        // 返回区域编号
+
+    const TextureRegion& getRegion(int id) const;
+    size_t getRegionCount() const { return m_regions.size(); }
+    size_t getPageCount() const { return m_pages.size(); }
+    const sf::Texture& getPage(size_t index) const { return *m_pages[index]; }
+    size_t getPageMemoryBytes() const; // 所有页的像素数据大小 (RGBA)
+
+private:
+    unsigned m_pageSize;
+    std::vector<sf::Image> m_images;                   // 等待打包的图片 (下标 = 区域编号)
+    std::vector<sf::Image> m_pageImages;               // pack() 拼出、尚未上传的页
+    std::vector<TextureRegion> m_regions;
+    std::vector<int> m_regionPages;                    // 各区域所在的页 (-1: 无效)
+    std::vector<std::unique_ptr<sf::Texture>> m_pages; // 指针地址固定，TextureRegion 可长期持有
+};
+
+#endif //TANKS_TEXTUREATLAS_H
@@ -0,0 +1,147 @@
+// TileChunkGrid.cpp
+#include "TileChunkGrid.h"
+#include <algorithm> // std::find, std::max
+
+TileChunkGrid::TileChunkGrid(WalkablePredicate isWalkable)
+        : m_isWalkable(isWalkable),
+          m_width(0), m_height(0), m_chunkColumns(0), m_chunkRows(0),
+          m_fill(0), m_fillWalkable(false),
+          m_residentChunks(0), m_compactChunks(0) {
+}
+
+void TileChunkGrid::reset(int width, int height, std::uint8_t fill) {
+    m_width = std::max(0, width);
+    m_height = std::max(0, height);
+    m_chunkColumns = (m_width + CHUNK_MASK) >> CHUNK_SHIFT;
+    m_chunkRows = (m_height + CHUNK_MASK) >> CHUNK_SHIFT;
+    m_fill = fill;
+    m_fillWalkable = m_isWalkable(fill);
+    m_chunks.clear();
+    m_chunks.resize(static_cast<size_t>(m_chunkColumns) * m_chunkRows);
+    m_residentChunks = 0;
+    m_compactChunks = 0;
+}
+
+// =========================================================================
+// 瓦片写入
+// =========================================================================
+void TileChunkGrid::set(int x, int y, std::uint8_t tile) {
+    Chunk& chunk = m_chunks[chunkIndexOf(x, y)];
+    if (chunk.state != ChunkState::Resident) {
+        if (get(x, y) == tile) return; // 值未变：不必为此分配或换入
+        makeResident(chunk);
+    }
+    const int local = localIndex(x, y);
+    chunk.resident->tiles[static_cast<size_t>(local)] = tile;
+    const std::uint64_t bit = std::uint64_t(1) << (local & 63);
+    if (m_isWalkable(tile)) {
+        chunk.resident->walkable[static_cast<size_t>(local >> 6)] |= bit;
+    } else {
+        chunk.resident->walkable[static_cast<size_t>(local >> 6)] &= ~bit;
+    }
+}
+
+TileChunkGrid::ResidentTiles& TileChunkGrid::makeResident(Chunk& chunk) {
+    chunk.resident = std::make_unique<ResidentTiles>();
+    if (chunk.state == ChunkState::Compact) {
+        for (int local = 0; local < CHUNK_TILES; ++local) {
+            chunk.resident->tiles[static_cast<size_t>(local)] =
+                    chunk.compact->palette[static_cast<size_t>(compactPaletteIndex(*chunk.compact, local))];
+        }
+        chunk.compact.reset();
+        --m_compactChunks;
+    } else {
+        chunk.resident->tiles.fill(m_fill);
+    }
+    rebuildWalkable(*chunk.resident);
+    chunk.state = ChunkState::Resident;
+    ++m_residentChunks;
+    return *chunk.resident;
+}
+
+void TileChunkGrid::rebuildWalkable(ResidentTiles& resident) const {
+    resident.walkable.fill(0);
+    for (int local = 0; local < CHUNK_TILES; ++local) {
+        if (m_isWalkable(resident.tiles[static_cast<size_t>(local)])) {
+            resident.walkable[static_cast<size_t>(local >> 6)] |= std::uint64_t(1) << (local & 63);
+        }
+    }
+}
+
+std::uint16_t TileChunkGrid::paletteWalkableMask(const std::vector<std::uint8_t>& palette) const {
+    std::uint16_t mask = 0;
+    for (size_t i = 0; i < palette.size(); ++i) {
+        if (m_isWalkable(palette[i])) mask = static_cast<std::uint16_t>(mask | (1u << i));
+    }
+    return mask;
+}
+
+// =========================================================================
+// 换入/换出
+// =========================================================================
+void TileChunkGrid::compactChunk(Chunk& chunk) {
+    const ResidentTiles& resident = *chunk.resident;
+
+    // 收集调色板；超过16种值时位宽不够，保持 Resident
+    std::vector<std::uint8_t> palette;
+    for (std::uint8_t tile : resident.tiles) {
+        if (std::find(palette.begin(), palette.end(), tile) == palette.end()) {
+            if (palette.size() == 16) return;
+            palette.push_back(tile);
+        }
+    }
+
+    if (palette.size() == 1 && palette[0] == m_fill) {
+        chunk.resident.reset(); // 整块都是填充值：直接释放
+        chunk.state = ChunkState::Empty;
+        --m_residentChunks;
+        return;
+    }
+
+    auto compact = std::make_unique<CompactTiles>();
+    compact->bitsPerTile = palette.size() <= 1 ? 0 : (palette.size() <= 2 ? 1 : (palette.size() <= 4 ? 2 : 4));
+    if (compact->bitsPerTile > 0) {
+        compact->packed.assign(static_cast<size_t>(CHUNK_TILES) * compact->bitsPerTile / 64, 0);
+        for (int local = 0; local < CHUNK_TILES; ++local) {
+            const std::uint64_t paletteIndex = static_cast<std::uint64_t>(
+                    std::find(palette.begin(), palette.end(), resident.tiles[static_cast<size_t>(local)]) - palette.begin());
+            const int bitOffset = local * compact->bitsPerTile;
+            compact->packed[static_cast<size_t>(bitOffset >> 6)] |= paletteIndex << (bitOffset & 63);
+        }
+    }
+    compact->walkableMask = paletteWalkableMask(palette);
+    compact->palette = std::move(palette);
+
+    chunk.compact = std::move(compact);
+    chunk.resident.reset();
+    chunk.state = ChunkState::Compact;
+    --m_residentChunks;
+    ++m_compactChunks;
+}
+
+size_t TileChunkGrid::updateResidency(const std::vector<std::uint8_t>& keepChunk) {
+    size_t changed = 0;
+    for (size_t i = 0; i < m_chunks.size(); ++i) {
+        Chunk& chunk = m_chunks[i];
+        const bool keep = i < keepChunk.size() && keepChunk[i] != 0;
+        if (keep && chunk.state == ChunkState::Compact) {
+            makeResident(chunk); // 实体靠近：换回可写的完整数组
+            ++changed;
+        } else if (!keep && chunk.state == ChunkState::Resident) {
+            compactChunk(chunk);
+            if (chunk.state != ChunkState::Resident) ++changed;
+        }
+    }
+    return changed;
+}
+
+size_t TileChunkGrid::getTileMemoryBytes() const {
+    size_t bytes = m_residentChunks * sizeof(ResidentTiles);
+    for (const Chunk& chunk : m_chunks) {
+        if (chunk.state == ChunkState::Compact) {
+            bytes += sizeof(CompactTiles) + chunk.compact->palette.capacity() +
+                     chunk.compact->packed.capacity() * sizeof(std::uint64_t);
+        }
+    }
+    return bytes;
+}
@@ -0,0 +1,156 @@
+#ifndef TANKS_TILECHUNKGRID_H
+#define TANKS_TILECHUNKGRID_H
+
+// =========================================================================
+// 必要的头文件包含
+// =========================================================================
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// =========================================================================
+// TileChunkGrid: 分块存储的瓦片网格 (每格一个字节，含义由 Map 决定)
+// =========================================================================
+// 地图切成 32x32 的固定大小块，每块有三种状态：
+//   - Empty:    从未写入，所有格子都等于填充值，不占用瓦片内存；
+//   - Resident: 完整的字节数组 + 可通行位图，读写都是 O(1)；
+//   - Compact:  调色板 + 按位打包的下标 (每格 0/1/2/4 位)，只读；写入时先换回 Resident。
+// 块在第一次写入不同于填充值的瓦片时才分配 (懒分配)；
+// updateResidency() 把远离所有实体的 Resident 块换出为 Compact (或全为填充值时直接释放为 Empty)。
+// 读取不做边界检查，由调用方 (Map) 负责。
+class TileChunkGrid {
+public:
+    static const int CHUNK_SHIFT = 5;
+    static const int CHUNK_SIZE = 1 << CHUNK_SHIFT;           // 每块边长 (格子数)
+    static const int CHUNK_MASK = CHUNK_SIZE - 1;
+    static const int CHUNK_TILES = CHUNK_SIZE * CHUNK_SIZE;
+
+    using WalkablePredicate = bool (*)(std::uint8_t tile);
+
+    explicit TileChunkGrid(WalkablePredicate isWalkable);
+
+    void reset(int width, int height, std::uint8_t fill); // 重新设定尺寸，所有块回到 Empty
+
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+    int getChunkColumns() const { return m_chunkColumns; }
+    int getChunkRows() const { return m_chunkRows; }
+    size_t getChunkCount() const { return m_chunks.size(); }
+    size_t chunkIndexOf(int x, int y) const { return static_cast<size_t>(y >> CHUNK_SHIFT) * m_chunkColumns + (x >> CHUNK_SHIFT); }
+    bool isEmpty() const { return m_chunks.empty(); }
+
+    // =========================================================================
+    // 瓦片访问 (不做边界检查)
+    // =========================================================================
+    std::uint8_t get(int x, int y) const;
+    bool isWalkable(int x, int y) const;
+    void set(int x, int y, std::uint8_t tile); // 按需分配或换入所在块
+
+    // 对所有格子 (含 Empty 块的填充值) 应用 fn；fn 只应依赖瓦片本身的值
+    template<class Fn> void transformAll(Fn fn);
+
+    // =========================================================================
+    // 换入/换出
+    // =========================================================================
+    // keepChunk[i] 非零的块保持 (或换入为) Resident，其余 Resident 块换出。返回状态发生变化的块数
+    size_t updateResidency(const std::vector<std::uint8_t>& keepChunk);
+
+    // 统计
+    size_t getResidentChunkCount() const { return m_residentChunks; }
+    size_t getCompactChunkCount() const { return m_compactChunks; }
+    size_t getEmptyChunkCount() const { return m_chunks.size() - m_residentChunks - m_compactChunks; }
+    size_t getTileMemoryBytes() const; // 瓦片数据实际占用的字节数 (不含块表本身)
+
+private:
+    enum class ChunkState : std::uint8_t { Empty, Resident, Compact };
+
+    struct ResidentTiles {
+        std::array<std::uint8_t, CHUNK_TILES> tiles;
+        std::array<std::uint64_t, CHUNK_TILES / 64> walkable; // 可通行位图，随 set() 同步
+    };
+
+    struct CompactTiles {
+        std::vector<std::uint8_t> palette;  // 块内出现过的瓦片值 (最多16种)
+        std::vector<std::uint64_t> packed;  // 每格的调色板下标；bitsPerTile 为0时为空
+        std::uint16_t walkableMask = 0;     // 第 i 位: palette[i] 是否可通行
+        std::uint8_t bitsPerTile = 0;       // 0/1/2/4，为2的幂以免下标跨越64位字
+    };
+
+    struct Chunk {
+        ChunkState state = ChunkState::Empty;
+        std::unique_ptr<ResidentTiles> resident;
+        std::unique_ptr<CompactTiles> compact;
+    };
+
+    static int localIndex(int x, int y) { return ((y & CHUNK_MASK) << CHUNK_SHIFT) | (x & CHUNK_MASK); }
+    static int compactPaletteIndex(const CompactTiles& compact, int local);
+
+    ResidentTiles& makeResident(Chunk& chunk);     // Empty/Compact -> Resident
+    void compactChunk(Chunk& chunk);               // Resident -> Compact/Empty (超过16种瓦片值时保持 Resident)
+    void rebuildWalkable(ResidentTiles& resident) const;
+    std::uint16_t paletteWalkableMask(const std::vector<std::uint8_t>& palette) const;
+
+    WalkablePredicate m_isWalkable;
+    int m_width;
+    int m_height;
+    int m_chunkColumns;
+    int m_chunkRows;
+    std::uint8_t m_fill;        // Empty 块的瓦片值
+    bool m_fillWalkable;
+    std::vector<Chunk> m_chunks; // 行优先，下标 = chunkY * m_chunkColumns + chunkX
+
+    size_t m_residentChunks;
+    size_t m_compactChunks;
+};
+
+// =========================================================================
+// 内联实现 (热点路径)
+// =========================================================================
+inline std::uint8_t TileChunkGrid::get(int x, int y) const {
+    const Chunk& chunk = m_chunks[chunkIndexOf(x, y)];
+    switch (chunk.state) {
+        case ChunkState::Resident: return chunk.resident->tiles[static_cast<size_t>(localIndex(x, y))];
+        case ChunkState::Compact: return chunk.compact->palette[static_cast<size_t>(compactPaletteIndex(*chunk.compact, localIndex(x, y)))];
+        default: return m_fill;
+    }
+}
+
+inline bool TileChunkGrid::isWalkable(int x, int y) const {
+    const Chunk& chunk = m_chunks[chunkIndexOf(x, y)];
+    switch (chunk.state) {
+        case ChunkState::Resident: {
+            const int local = localIndex(x, y);
+            return (chunk.resident->walkable[static_cast<size_t>(local >> 6)] >> (local & 63)) & 1u;
+        }
+        case ChunkState::Compact:
+            return (chunk.compact->walkableMask >> compactPaletteIndex(*chunk.compact, localIndex(x, y))) & 1u;
+        default: return m_fillWalkable;
+    }
+}
+
+inline int TileChunkGrid::compactPaletteIndex(const CompactTiles& compact, int local) {
+    if (compact.bitsPerTile == 0) return 0;
+    const int bitOffset = local * compact.bitsPerTile;
+    const std::uint64_t word = compact.packed[static_cast<size_t>(bitOffset >> 6)];
+    return static_cast<int>((word >> (bitOffset & 63)) & ((std::uint64_t(1) << compact.bitsPerTile) - 1));
+}
+
+template<class Fn>
+void TileChunkGrid::transformAll(Fn fn) {
+    m_fill = fn(m_fill);
+    m_fillWalkable = m_isWalkable(m_fill);
+    for (Chunk& chunk : m_chunks) {
+        if (chunk.state == ChunkState::Resident) {
+            for (std::uint8_t& tile : chunk.resident->tiles) tile = fn(tile);
+            rebuildWalkable(*chunk.resident);
+        } else if (chunk.state == ChunkState::Compact) {
+            // 调色板变换后可能出现重复值，不影响读取结果
+            for (std::uint8_t& value : chunk.compact->palette) value = fn(value);
+            chunk.compact->walkableMask = paletteWalkableMask(chunk.compact->palette);
+        }
+    }
+}
+
+#endif //TANKS_TILECHUNKGRID_H
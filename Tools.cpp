@@ -5,24 +5,37 @@
 #include "heads.h"
 #include "Tools.h"
 #include "tank.h"
+#include "SpriteBatch.h"
 
-Tools::Tools(sf::Vector2f position, const sf::Texture& texture):m_position(position),m_isActive(true){
-    m_sprite.setPosition(position);
-    sf::FloatRect bounds = m_sprite.getGlobalBounds();
+Tools::Tools(sf::Vector2f position, const TextureRegion& texture):m_position(position),m_isActive(true){
+    texture.applyTo(m_sprite);
+    sf::FloatRect bounds = m_sprite.getLocalBounds();
     m_sprite.setOrigin(bounds.width / 2, bounds.height / 2);
     m_sprite.setPosition(m_position);
+    initHitboxSize(texture);
     m_lifetime = sf::seconds(20.f); // 默认生命周期为10秒
     m_age = sf::Time::Zero;
 }
 
-Tools::Tools(sf::Vector2f position, const sf::Texture& texture, sf::Time lifetime)
+Tools::Tools(sf::Vector2f position, const TextureRegion& texture, sf::Time lifetime)
         : m_position(position),
           m_isActive(true),
           m_lifetime(lifetime), // 使用传入的生命周期
           m_age(sf::Time::Zero) {
+    texture.applyTo(m_sprite);
     sf::FloatRect bounds = m_sprite.getLocalBounds();
     m_sprite.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
     m_sprite.setPosition(m_position);
+    initHitboxSize(texture);
+}
+
+void Tools::initHitboxSize(const TextureRegion& texture) {
+    // 有纹理时碰撞盒与纹理一致；无界面模式下纹理为空，使用默认尺寸
+    if (texture.getSize().x > 0 && texture.getSize().y > 0) {
+        m_size = sf::Vector2f(static_cast<float>(texture.getSize().x), static_cast<float>(texture.getSize().y));
+    } else {
+        m_size = sf::Vector2f(DEFAULT_HITBOX_SIZE, DEFAULT_HITBOX_SIZE);
+    }
 }
 
 void Tools::update(sf::Time dt) {
@@ -34,14 +47,14 @@ void Tools::update(sf::Time dt) {
 
     if (m_age >= m_lifetime) { // 如果道具已超过其生命周期
         setActive(false);      // 将道具设为不活动状态
-        std::cout << "Tool at (" << getPosition().x << ", " << getPosition().y << ") timed out and disappeared." << std::endl;
+        LOG_DEBUG("Tool at (" << getPosition().x << ", " << getPosition().y << ") timed out and disappeared.");
     }
     // 其他特定于道具的更新逻辑可以放在这里或派生类中
 }
 
-void Tools::draw(sf::RenderWindow& window) {
+void Tools::draw(SpriteBatch& batch) {
     if(m_isActive) {
-        window.draw(m_sprite);
+        batch.add(m_sprite);
     }
 }
 
@@ -59,7 +72,7 @@ sf::Vector2f Tools::getPosition() const {
 
 sf::FloatRect Tools::getBound() const {
     if(m_isActive) {
-        return m_sprite.getGlobalBounds();
+        return sf::FloatRect(m_position.x - m_size.x / 2.f, m_position.y - m_size.y / 2.f, m_size.x, m_size.y);
     } else {
         return sf::FloatRect();
     }
@@ -0,0 +1,97 @@
+// Trace.cpp
+#include "Trace.h"
+#include "Log.h"
+#include <algorithm> // std::min
+#include <fstream>
+#include <iomanip>   // std::setprecision
+
+TraceRecorder& TraceRecorder::instance() {
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+TraceRecorder::TraceRecorder() : m_epoch(Clock::now()), m_capacity(0) {}
+
+std::uint32_t TraceRecorder::currentThreadId() {
+    static std::atomic<std::uint32_t> nextThreadId{1};
+    thread_local const std::uint32_t threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    return threadId;
+}
+
+void TraceRecorder::start(size_t capacityEvents) {
+    m_recording.store(false, std::memory_order_relaxed);
+    m_capacity = std::max<size_t>(1, capacityEvents);
+    m_events.reset(new Event[m_capacity]); // 一次性分配，记录过程中不再分配
+    m_next.store(0, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+    setThreadName("main");
+    m_recording.store(true, std::memory_order_release);
+    LOG_INFO("Trace recording started (" << m_capacity << " events, "
+             << m_capacity * sizeof(Event) / 1024 << " KiB buffer)");
+}
+
+void TraceRecorder::stop() {
+    m_recording.store(false, std::memory_order_release);
+}
+
+void TraceRecorder::clear() {
+    m_next.store(0, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+}
+
+void TraceRecorder::record(const char* name, Clock::time_point start, Clock::time_point end) {
+    if (!m_recording.load(std::memory_order_relaxed)) return;
+    const size_t index = m_next.fetch_add(1, std::memory_order_relaxed);
+    if (index >= m_capacity) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Event& event = m_events[index];
+    event.name = name;
+    event.startNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(start - m_epoch).count();
+    event.durationNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    event.threadId = currentThreadId();
+}
+
+void TraceRecorder::setThreadName(const char* name) {
+    const std::uint32_t threadId = currentThreadId();
+    std::lock_guard<std::mutex> lock(m_threadNameMutex);
+    for (auto& [id, threadName] : m_threadNames) {
+        if (id == threadId) { threadName = name; return; }
+    }
+    m_threadNames.emplace_back(threadId, name);
+}
+
+size_t TraceRecorder::getEventCount() const {
+    return std::min(m_next.load(std::memory_order_acquire), m_capacity);
+}
+
+bool TraceRecorder::writeJson(const std::string& path) const {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_ERROR("TraceRecorder::writeJson() - Error: Failed to open '" << path << "' for writing.");
+        return false;
+    }
+    // 时间单位为微秒 (保留到纳秒)；所有事件属于同一进程 (pid 1)，tid 为 currentThreadId()
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    {
+        std::lock_guard<std::mutex> lock(m_threadNameMutex);
+        for (const auto& [id, threadName] : m_threadNames) {
+            file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << id
+                 << ",\"args\":{\"name\":\"" << threadName << "\"}}";
+            first = false;
+        }
+    }
+    file << std::fixed << std::setprecision(3);
+    const size_t count = getEventCount();
+    for (size_t i = 0; i < count; ++i) {
+        const Event& event = m_events[i];
+        file << (first ? "" : ",\n") << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId
+             << ",\"ts\":" << event.startNanos / 1000.0 << ",\"dur\":" << event.durationNanos / 1000.0 << "}";
+        first = false;
+    }
+    file << "\n]}\n";
+    LOG_INFO("Trace written to '" << path << "' (" << count << " events, " << getDroppedCount() << " dropped)");
+    return file.good();
+}
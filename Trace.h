@@ -0,0 +1,89 @@
+#ifndef TANKS_TRACE_H
+#define TANKS_TRACE_H
+
+// =========================================================================
+// 必要的头文件包含
+// =========================================================================
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// =========================================================================
+// TraceRecorder: 按线程记录各阶段的开始/结束，导出为 Chrome trace (JSON)
+// =========================================================================
+// start() 一次性分配事件缓冲，之后 record() 只用原子下标领取槽位 (多线程安全、不加锁、不分配)，
+// 缓冲写满后丢弃新事件并计数。每个事件同时保存开始时间与时长 (trace 中的 "X" 完整事件，
+// 等价于一对 B/E 事件)。writeJson() 生成的文件可直接在 chrome://tracing 或 Perfetto 中打开。
+// 事件名必须是静态字符串 (字面量或 getProfilePhaseName 等)，缓冲中只保存指针。
+class TraceRecorder {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static TraceRecorder& instance();
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    void start(size_t capacityEvents); // 分配缓冲并开始记录 (调用线程命名为 "main")
+    void stop();                       // 停止记录，已记录的事件保留到 clear()
+    void clear();
+    bool isRecording() const { return m_recording.load(std::memory_order_relaxed); }
+
+    void record(const char* name, Clock::time_point start, Clock::time_point end);
+    void setThreadName(const char* name); // 为当前线程命名 (写入 trace 的线程元数据)
+
+    // 写出到目前为止的所有事件；应在其他线程没有记录时调用 (例如主线程帧与帧之间)
+    bool writeJson(const std::string& path) const;
+
+    size_t getEventCount() const;
+    std::uint64_t getDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    TraceRecorder();
+    static std::uint32_t currentThreadId(); // 进程内从1开始的小整数
+
+    struct Event {
+        const char* name;
+        std::int64_t startNanos; // 相对 m_epoch
+        std::int64_t durationNanos;
+        std::uint32_t threadId;
+    };
+
+    Clock::time_point m_epoch;
+    std::unique_ptr<Event[]> m_events;
+    size_t m_capacity;
+    std::atomic<size_t> m_next{0};
+    std::atomic<std::uint64_t> m_dropped{0};
+    std::atomic<bool> m_recording{false};
+
+    mutable std::mutex m_threadNameMutex;     // 线程命名很少发生，加锁即可
+    std::vector<std::pair<std::uint32_t, std::string>> m_threadNames;
+};
+
+// TraceScope: 作用域事件 (未在记录时只有一次原子读)
+class TraceScope {
+public:
+    explicit TraceScope(const char* name)
+            : m_name(name), m_active(TraceRecorder::instance().isRecording()),
+              m_start(m_active ? TraceRecorder::Clock::now() : TraceRecorder::Clock::time_point()) {}
+    ~TraceScope() {
+        if (m_active) TraceRecorder::instance().record(m_name, m_start, TraceRecorder::Clock::now());
+    }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_name;
+    bool m_active;
+    TraceRecorder::Clock::time_point m_start;
+};
+
+#define TANKS_TRACE_CONCAT_INNER(a, b) a##b
+#define TANKS_TRACE_CONCAT(a, b) TANKS_TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) TraceScope TANKS_TRACE_CONCAT(tanksTraceScope, __LINE__)(name)
+
+#endif //TANKS_TRACE_H
@@ -0,0 +1,910 @@
+// World.cpp
+
+// =========================================================================
+// 必要的头文件包含
+// =========================================================================
+#include "World.h"
+#include "ResourceManager.h"
+#include "PlayerTank.h" // 玩家坦克类
+#include "AITank.h"     // AI坦克类
+#include "BulletSystem.h" // 子弹 (SoA 存储)
+#include "Map.h"        // 地图类
+
+// 道具类头文件
+#include "AddArmor.h"
+#include "AddAttack.h"
+#include "AddAttackSpeed.h"
+#include "AddSpeed.h"
+#include "Grenade.h"
+#include "SlowDownAI.h"
+
+#include <iostream>     // 用于标准输入输出 (例如 std::cout, std::cerr)
+#include <vector>       // 用于 std::vector
+#include <algorithm>    // 用于 std::remove_if 等算法
+#include <random>       // 用于随机数生成
+#include <string>       // 用于 std::string 和 std::to_string
+#include <cmath>        // 用于 std::sqrt
+
+// =========================================================================
+// 构造函数与析构函数
+// =========================================================================
+World::World(const ResourceManager* resources)
+        : m_resources(resources),
+          m_map(),
+          m_rng(std::random_device{}()), // 初始化随机数生成器
+          m_playerTankPtr(nullptr),
+          m_tankPairTests(0),
+          m_bulletTankTests(0),
+          m_tankCollisionsResolved(0),
+          m_useReservations(true),
+          m_tickCount(0),
+          m_chunkKeepRadius(2),
+          m_chunkResidencyInterval(120),
+          m_profiler(nullptr),
+          m_score(0),
+          m_currentLevel(1), // 从第一关开始
+          m_playerWantsToMove(false),
+          m_playerMoveDirection(Direction::UP),
+          m_toolSpawnInterval(sf::seconds(10.0f)),
+          m_toolSpawnTimer(sf::Time::Zero),
+          m_aiTankSpawnInterval(sf::seconds(8.0f)), // AI生成间隔可以随关卡调整
+          m_aiTankSpawnTimer(sf::Time::Zero),
+          m_maxActiveAITanks(5), // 初始AI数量可以少一些
+          m_configMaxActiveAITanks(5),
+          m_configAITankSpawnInterval(sf::seconds(8.0f)),
+          m_useLevelPresets(true),
+          m_defaultAITankSpeed(30.f),
+          m_defaultAIBaseHealth(80),
+          m_defaultAIBaseAttack(15),
+          m_defaultAIFrameWidth(50),
+          m_defaultAIFrameHeight(50),
+          m_defaultAIScoreValue(100)
+{
+}
+
+World::~World() = default;
+
+// =========================================================================
+// 初始化
+// =========================================================================
+bool World::init(const nlohmann::json& config) {
+    loadToolTypesFromConfig(config); // 从配置中加载可用道具类型
+    loadAITankConfigs(config);       // 从配置中加载AI坦克类型及其属性
+
+    // 从配置中读取AI坦克全局生成参数 (max_active, spawn_interval_seconds)
+    if (config.contains("ai_settings")) {
+        m_maxActiveAITanks = config["ai_settings"].value("max_active", m_maxActiveAITanks);
+        float spawnIntervalSeconds = config["ai_settings"].value("spawn_interval_seconds", m_aiTankSpawnInterval.asSeconds());
+        m_aiTankSpawnInterval = sf::seconds(spawnIntervalSeconds);
+        m_useLevelPresets = config["ai_settings"].value("use_level_presets", true);
+        LOG_INFO("Global AI Settings loaded: MaxActive=" << m_maxActiveAITanks
+                  << ", SpawnInterval=" << spawnIntervalSeconds << "s");
+    } else {
+        LOG_WARN("Warning: Global AI Settings (max_active, etc.) not found in config.json, using hardcoded defaults.");
+    }
+
+    m_configMaxActiveAITanks = m_maxActiveAITanks;
+    m_configAITankSpawnInterval = m_aiTankSpawnInterval;
+
+    // 初始化地图尺寸
+    if (!m_map.loadDimensionsAndTextures(m_resources)) {
+        LOG_ERROR("CRITICAL ERROR: Failed to load map dimensions/textures in World::init().");
+        return false;
+    }
+    LOG_INFO("Map dimensions and textures loaded successfully.");
+    loadMapConfig(config);
+
+    initializeBulletPool(config);
+    loadPathfindingConfig(config);
+
+    // 重置计时器
+    m_toolSpawnTimer = sf::Time::Zero;
+    m_aiTankSpawnTimer = sf::Time::Zero;
+    return true;
+}
+
+void World::reseed(unsigned int seed) {
+    m_rng.seed(seed);
+}
+
+void World::setupLevel() {
+    LOG_INFO("Setting up Level " << m_currentLevel);
+
+    // =========================================================================
+    // 关键步骤：清理上一关的实体
+    // =========================================================================
+    m_pathRequests.clear();    // 寻路请求同样只保存裸指针
+    m_reservations.clear();    // 预留表以坦克指针为键
+    m_aiTanks.clear();         // AI 列表只保存裸指针，须与 m_all_tanks 一起清空
+    m_all_tanks.clear();       // 清空所有现有坦克
+    m_playerTankPtr = nullptr; // 重置玩家坦克指针
+    m_tools.clear();           // 清空所有道具
+
+    // 重置子弹对象池中的所有子弹为不活动状态
+    m_bullets.clear();
+    LOG_INFO("Entities from previous level (or existing ones) cleared.");
+
+    // 2. 生成新地图布局
+    if (m_map.getMapWidth() <= 0 || m_map.getMapHeight() <= 0) {
+        LOG_ERROR("CRITICAL ERROR in setupLevel: Map dimensions not properly set. Attempting to load them.");
+        if (!m_map.loadDimensionsAndTextures(m_resources)) {
+            LOG_ERROR("CRITICAL ERROR in setupLevel: Failed to load map dimensions. Cannot proceed.");
+            return;
+        }
+    }
+    m_map.generateLayout(m_currentLevel, m_rng, *this);
+    m_map.resetForNewLevel();
+    // 空间哈希每tick要清零全部格子：大地图上按2的幂合并瓦片，使格子数不超过 MAX_GRID_CELLS
+    const int MAX_GRID_CELLS = 1 << 14;
+    int gridScale = 1;
+    while (static_cast<long long>((m_map.getMapWidth() + gridScale - 1) / gridScale) *
+           ((m_map.getMapHeight() + gridScale - 1) / gridScale) > MAX_GRID_CELLS) {
+        gridScale *= 2;
+    }
+    m_tankGrid.configure(static_cast<float>(m_map.getTileWidth() * gridScale), static_cast<float>(m_map.getTileHeight() * gridScale),
+                         (m_map.getMapWidth() + gridScale - 1) / gridScale, (m_map.getMapHeight() + gridScale - 1) / gridScale);
+    m_baseFlowField.build(m_map, m_map.getBaseTileCoordinate()); // 所有AI共享的“通往基地”距离场
+    m_reservations.configure(m_map.getMapWidth(), m_map.getMapHeight());
+
+    // 3. 重新创建/放置玩家坦克
+    sf::Vector2f playerStartPos;
+    bool spawnPointFound = false;
+
+    std::vector<sf::Vector2i> preferredSpawnTiles;
+    for (int y_offset = 0; y_offset < 3; ++y_offset) {
+        for (int x_offset = 0; x_offset < 5; ++x_offset) {
+            int spawnX = 1 + x_offset;
+            int spawnY = m_map.getMapHeight() - 2 - y_offset;
+            if (spawnX < m_map.getMapWidth() -1 && spawnY > 0) {
+                preferredSpawnTiles.push_back(sf::Vector2i(spawnX, spawnY));
+            }
+        }
+    }
+    sf::Vector2i baseCoord = m_map.getBaseTileCoordinate();
+    if (baseCoord.x != -1 && baseCoord.y != -1) {
+        if(baseCoord.x - 2 > 0 && baseCoord.y - 2 > 0)
+            preferredSpawnTiles.push_back(sf::Vector2i(baseCoord.x - 2, baseCoord.y - 2));
+        if(baseCoord.x + 2 < m_map.getMapWidth() - 1 && baseCoord.y - 2 > 0)
+            preferredSpawnTiles.push_back(sf::Vector2i(baseCoord.x + 2, baseCoord.y - 2));
+    }
+
+    for (const auto& tile : preferredSpawnTiles) {
+        if (tile.x > 0 && tile.x < m_map.getMapWidth() - 1 &&
+            tile.y > 0 && tile.y < m_map.getMapHeight() - 1 &&
+            m_map.isTileWalkable(tile.x, tile.y)) {
+            playerStartPos = sf::Vector2f(
+                    static_cast<float>(tile.x * m_map.getTileWidth()) + m_map.getTileWidth() / 2.0f,
+                    static_cast<float>(tile.y * m_map.getTileHeight()) + m_map.getTileHeight() / 2.0f
+            );
+            spawnPointFound = true;
+            LOG_INFO("Player spawn point found at preferred tile (" << tile.x << ", " << tile.y << ").");
+            break;
+        }
+    }
+
+    if (!spawnPointFound) {
+        LOG_WARN("Warning: Could not find preferred player spawn point. Searching broadly...");
+        for (int y = m_map.getMapHeight() - 2; y > 0 && !spawnPointFound; --y) {
+            for (int x = 1; x < m_map.getMapWidth() - 1 && !spawnPointFound; ++x) {
+                if (m_map.isTileWalkable(x, y)) {
+                    playerStartPos = sf::Vector2f(
+                            static_cast<float>(x * m_map.getTileWidth()) + m_map.getTileWidth() / 2.0f,
+                            static_cast<float>(y * m_map.getTileHeight()) + m_map.getTileHeight() / 2.0f
+                    );
+                    spawnPointFound = true;
+                    LOG_INFO("Fallback player spawn point found at tile (" << x << ", " << y << ").");
+                }
+            }
+        }
+    }
+
+    if (!spawnPointFound) {
+        LOG_ERROR("CRITICAL ERROR: No walkable tile found for player spawn! Defaulting to top-left.");
+        playerStartPos = sf::Vector2f(
+                static_cast<float>(m_map.getTileWidth() * 1.5f),
+                static_cast<float>(m_map.getTileHeight() * 1.5f)
+        );
+    }
+
+    auto player = std::make_unique<PlayerTank>(playerStartPos, Direction::UP, *this); // 创建新的玩家坦克
+    m_playerTankPtr = player.get();                     // 更新指针
+    m_all_tanks.push_back(std::move(player));           // 将新的玩家坦克添加到列表中
+    LOG_INFO("Player tank recreated for Level " << m_currentLevel << " at pixel (" << playerStartPos.x << ", " << playerStartPos.y << ").");
+
+    // 4. 重置AI和道具的生成计时器
+    m_aiTankSpawnTimer = sf::Time::Zero;
+    m_toolSpawnTimer = sf::Time::Zero;
+
+    // 5. 根据关卡调整AI参数 (配置中 use_level_presets 为 false 时沿用配置值，用于压力测试)
+    if (!m_useLevelPresets) {
+        m_maxActiveAITanks = m_configMaxActiveAITanks;
+        m_aiTankSpawnInterval = m_configAITankSpawnInterval;
+    } else if (m_currentLevel == 1) {
+        m_maxActiveAITanks = 5;
+        m_aiTankSpawnInterval = sf::seconds(8.0f);
+    } else if (m_currentLevel == 2) {
+        m_maxActiveAITanks = 7;
+        m_aiTankSpawnInterval = sf::seconds(6.5f);
+    } else if (m_currentLevel >= 3) {
+        m_maxActiveAITanks = 9;
+        m_aiTankSpawnInterval = sf::seconds(5.0f);
+    }
+    LOG_INFO("AI parameters for Level " << m_currentLevel << ": MaxActive=" << m_maxActiveAITanks
+              << ", SpawnInterval=" << m_aiTankSpawnInterval.asSeconds() << "s.");
+}
+
+bool World::advanceToNextLevel() {
+    if (m_currentLevel < MAX_LEVEL) {
+        m_currentLevel++;
+        LOG_INFO("Advancing to Level " << m_currentLevel);
+        // 分数不清零，因为是总分判断
+        setupLevel();
+        return true;
+    }
+    LOG_INFO("Congratulations! You have completed all levels!");
+    return false;
+}
+
+void World::resetMatch() {
+    m_score = 0;
+    m_currentLevel = 1; // 重置到第一关
+    setupLevel();       // 这会清理实体并设置第一关
+}
+
+bool World::shouldAdvanceLevel() const {
+    return (m_currentLevel == 1 && m_score >= SCORE_THRESHOLD_LEVEL_2) ||
+           (m_currentLevel == 2 && m_score >= SCORE_THRESHOLD_LEVEL_3);
+}
+
+// =========================================================================
+// 模拟推进
+// =========================================================================
+void World::step(sf::Time dt) {
+    TRACE_SCOPE("World::step");
+    ++m_tickCount;
+    PhaseTimer phaseTimer(m_profiler); // 每个编号阶段结束时 lap()，耗时记入对应的 ProfilePhase
+
+    // 1. 记录本tick开始时的位置，渲染时在上一tick与当前tick之间插值
+    for (auto& tankPtr : m_all_tanks) {
+        if (tankPtr) {
+            tankPtr->storePreviousPosition();
+        }
+    }
+
+    // 2. 应用玩家移动意图 (按固定 dt 积分)
+    if (m_playerWantsToMove && m_playerTankPtr && !m_playerTankPtr->isDestroyed()) {
+        float distance = m_playerTankPtr->getSpeed() * dt.asSeconds();
+        sf::Vector2f offset(0.f, 0.f);
+        switch (m_playerMoveDirection) {
+            case Direction::LEFT:  offset.x = -distance; break;
+            case Direction::RIGHT: offset.x = distance;  break;
+            case Direction::UP:    offset.y = -distance; break;
+            case Direction::DOWN:  offset.y = distance;  break;
+        }
+        m_playerTankPtr->setDirection(m_playerMoveDirection, *this);
+        m_playerTankPtr->move(m_playerTankPtr->get_position() + offset, m_map);
+    }
+
+    // 3. 更新所有坦克的基础状态 (动画、通用计时器等)
+    for(auto& tankPtr : m_all_tanks) {
+        if(tankPtr && !tankPtr->isDestroyed()) {
+            tankPtr->update(dt, *this);
+        }
+    }
+    phaseTimer.lap(ProfilePhase::TankUpdate);
+
+    // 4. 更新AI坦克的特定逻辑 (移动决策、格子间移动、自动射击)
+    //    直接遍历 AI 列表 (与 m_all_tanks 中的相对顺序一致)，不再逐个 dynamic_cast
+    //    先把上一tick被打坏/打穿的砖墙增量同步到共享流场
+    m_baseFlowField.update(m_map);
+    //    停在格子中心的追击型AI提交寻路请求，在本tick预算内按优先级处理；没轮到的沿旧路径继续走
+    if (m_playerTankPtr && !m_playerTankPtr->isDestroyed()) {
+        for (AITank* aiTankPtr : m_aiTanks) {
+            if (aiTankPtr->getBehavior() == AIBehavior::HuntPlayer && !aiTankPtr->isDestroyed() && !aiTankPtr->isMoving() &&
+                !(m_useReservations && aiTankPtr->isYielding(m_tickCount))) {
+                m_pathRequests.submit(aiTankPtr, m_tickCount);
+            }
+        }
+    }
+    m_pathRequests.process(m_map, m_playerTankPtr, m_tickCount);
+    //    决策时在时空预留表上互相让行 (先决策的AI先预留)
+    m_reservations.beginTick(m_tickCount, dt.asSeconds());
+    ReservationTable* reservations = m_useReservations ? &m_reservations : nullptr;
+    for (AITank* aiTankPtr : m_aiTanks) {
+        if (!aiTankPtr->isDestroyed()) {
+            if (!aiTankPtr->isMoving()) {
+                aiTankPtr->decideNextAction(m_map, m_playerTankPtr, &m_baseFlowField, reservations);
+            }
+            aiTankPtr->updateMovementBetweenTiles(dt, m_map);
+
+            if (aiTankPtr->canShootAI()) {
+                aiTankPtr->shoot(*this);
+                aiTankPtr->resetShootTimerAI();
+            }
+        }
+    }
+    phaseTimer.lap(ProfilePhase::AIDecision);
+
+    // 5. 处理坦克间的碰撞 (空间哈希宽相：只测试相邻格子中的坦克对)
+    m_tankGrid.clear();
+    for (size_t i = 0; i < m_all_tanks.size(); ++i) {
+        if (m_all_tanks[i] && !m_all_tanks[i]->isDestroyed()) {
+            m_tankGrid.insert(static_cast<int>(i), m_all_tanks[i]->getBounds());
+        }
+    }
+    m_tankGrid.build();
+
+    m_tankPairTests = 0;
+    m_tankCollisionsResolved = 0;
+    for (size_t i = 0; i < m_all_tanks.size(); ++i) {
+        if (!m_all_tanks[i] || m_all_tanks[i]->isDestroyed()) continue;
+        m_tankGrid.query(m_all_tanks[i]->getBounds(), m_gridQueryResult);
+        for (int candidate : m_gridQueryResult) {
+            size_t j = static_cast<size_t>(candidate);
+            if (j <= i) continue; // 每对只处理一次
+            ++m_tankPairTests;
+            if (m_all_tanks[i]->getBounds().intersects(m_all_tanks[j]->getBounds())) {
+                ++m_tankCollisionsResolved;
+                resolveTankCollision(m_all_tanks[i].get(), m_all_tanks[j].get());
+            }
+        }
+    }
+    phaseTimer.lap(ProfilePhase::TankCollision);
+
+    // 6. 更新所有活跃子弹的状态 (移动)
+    m_bullets.update(dt);
+    phaseTimer.lap(ProfilePhase::BulletMove);
+
+    // 7. 处理碰撞逻辑
+    //    坦克按其AABB覆盖的瓦片分桶 (碰撞推挤后重建一次)，每颗子弹只测试所在瓦片中的坦克
+    m_tankGrid.clear();
+    for (size_t i = 0; i < m_all_tanks.size(); ++i) {
+        if (m_all_tanks[i] && !m_all_tanks[i]->isDestroyed()) {
+            m_tankGrid.insert(static_cast<int>(i), m_all_tanks[i]->getBounds());
+        }
+    }
+    m_tankGrid.build();
+
+    m_bulletTankTests = 0;
+    //    a. 子弹与坦克的碰撞
+    // 只遍历存活子弹，且从尾部向前：kill() 会把末尾的子弹搬到当前下标，而那颗子弹已经处理过
+    for (size_t b = m_bullets.getActiveCount(); b-- > 0;) {
+        sf::FloatRect bulletBounds = m_bullets.getBounds(b);
+        m_tankGrid.query(bulletBounds, m_gridQueryResult);
+
+        // 与原先按 m_all_tanks 顺序遍历保持一致：命中多个坦克时取下标最小的一个
+        // (玩家子弹不伤玩家 / AI子弹不伤AI 之类的规则如需要可在此按 getType() 过滤)
+        size_t hitIndex = m_all_tanks.size();
+        for (int candidate : m_gridQueryResult) {
+            size_t idx = static_cast<size_t>(candidate);
+            Tank* tank = m_all_tanks[idx].get();
+            if (!tank || tank->isDestroyed()) continue;
+            ++m_bulletTankTests;
+            if (idx < hitIndex && bulletBounds.intersects(tank->getBounds())) {
+                hitIndex = idx;
+            }
+        }
+
+        if (hitIndex < m_all_tanks.size()) {
+            auto& tankPtr = m_all_tanks[hitIndex];
+            tankPtr->takeDamage(m_bullets.getDamage(b));
+            m_bullets.kill(b);
+            if (tankPtr->isDestroyed()) {
+                if (tankPtr->isAI()) {
+                    m_score += tankPtr->getScoreValue();
+                    LOG_DEBUG("AI Tank (type: " << tankPtr->getTankType() << ") destroyed! Player Score: " << m_score);
+                } else if (tankPtr.get() == m_playerTankPtr) {
+                    LOG_DEBUG("Player Tank destroyed by bullet!");
+                }
+            }
+            continue; // 子弹已被坦克碰撞处理，跳过与地图的碰撞
+        }
+
+        // b. 子弹与地图的碰撞 (扫掠检测)
+        // 检查本tick从上一位置到当前位置途经的所有格子，而不只是终点所在的格子，
+        // 这样长帧或高速子弹也不会穿过砖墙。只结算第一个阻挡格子。
+        sf::Vector2i hitTile;
+        int tileTypeHit = m_map.traceBulletPath(m_bullets.getPreviousPosition(b), m_bullets.getPosition(b), hitTile);
+        if (tileTypeHit == Map::TRACE_OUT_OF_BOUNDS) { // 子弹飞出地图边界
+            m_bullets.kill(b);
+        } else if (tileTypeHit != Map::TRACE_CLEAR) {
+            if (tileTypeHit == 1) { // 砖墙
+                m_map.damageTile(hitTile.x, hitTile.y, 1, *this);
+            } else if (tileTypeHit == 3) { // 基地
+                m_map.damageBase(m_bullets.getDamage(b));
+            }
+            // 钢墙(2)只阻挡；水(4)和森林(5)子弹可以穿过，traceBulletPath 不会停在这些格子上
+            m_bullets.kill(b);
+        }
+    }
+    phaseTimer.lap(ProfilePhase::BulletCollision);
+
+    // 8. 更新道具逻辑 (生成、生命周期、碰撞)
+    updateTools(dt);
+    phaseTimer.lap(ProfilePhase::Tools);
+
+    // 9. 更新AI坦克生成逻辑
+    updateAITankSpawning(dt);
+    phaseTimer.lap(ProfilePhase::Spawning);
+
+    // 10. 清理被摧毁的坦克 (先清理寻路请求与 AI 列表中的裸指针，再释放坦克对象)
+    m_pathRequests.removeDestroyed();
+    m_reservations.releaseDestroyed();
+    m_aiTanks.erase(std::remove_if(m_aiTanks.begin(), m_aiTanks.end(),
+                                   [](const AITank* aiTank) { return aiTank->isDestroyed(); }),
+                    m_aiTanks.end());
+    m_all_tanks.erase(std::remove_if(m_all_tanks.begin(), m_all_tanks.end(),
+                                     [&](const std::unique_ptr<Tank>& tank_to_check) {
+                                         bool should_remove = tank_to_check && tank_to_check->isDestroyed();
+                                         if (should_remove) {
+                                             if (tank_to_check.get() == m_playerTankPtr) {
+                                                 m_playerTankPtr = nullptr; // 玩家坦克被移除，指针置空
+                                                 LOG_DEBUG("Player tank pointer (m_playerTankPtr) set to nullptr after being destroyed and removed.");
+                                             }
+                                         }
+                                         return should_remove;
+                                     }),
+                      m_all_tanks.end());
+
+    // 11. 定期把远离所有坦克的地图块换出为紧凑形式 (坦克靠近时换回)
+    if (m_chunkResidencyInterval > 0 && m_tickCount % static_cast<std::uint64_t>(m_chunkResidencyInterval) == 0 &&
+        m_map.getTileWidth() > 0 && m_map.getTileHeight() > 0) {
+        m_activeTiles.clear();
+        for (const auto& tankPtr : m_all_tanks) {
+            if (!tankPtr) continue;
+            const sf::Vector2f pos = tankPtr->get_position();
+            m_activeTiles.emplace_back(static_cast<int>(pos.x) / m_map.getTileWidth(), static_cast<int>(pos.y) / m_map.getTileHeight());
+        }
+        m_map.updateChunkResidency(m_activeTiles, m_chunkKeepRadius);
+    }
+    phaseTimer.lap(ProfilePhase::Cleanup);
+}
+
+// =========================================================================
+// 内部初始化与加载方法
+// =========================================================================
+void World::loadToolTypesFromConfig(const nlohmann::json& config) {
+    m_availableToolTypes.clear();
+    if (config.contains("textures") && config["textures"].contains("props")) {
+        for (auto& [key, pathNode] : config["textures"]["props"].items()) {
+            // 只需要键名，路径在加载纹理时已使用
+            m_availableToolTypes.push_back(key);
+            LOG_INFO("Found available tool type from config: " << key);
+        }
+    }
+    if (m_availableToolTypes.empty()) {
+        LOG_WARN("Warning: No tool types found in config.json under textures.props. No tools will be spawned.");
+    }
+}
+
+void World::loadAITankConfigs(const nlohmann::json& config) {
+    m_aiTypeConfigs.clear();
+    m_availableAITankTypeNames.clear();
+
+    if (config.contains("ai_settings") && config["ai_settings"].contains("ai_types")) {
+        const auto& aiSettings = config["ai_settings"];
+        const auto& aiTypesNode = aiSettings["ai_types"];
+        for (auto it = aiTypesNode.begin(); it != aiTypesNode.end(); ++it) {
+            const std::string& typeName = it.key();
+            const auto& configNode = it.value();
+
+            try {
+                AITankTypeConfig typeConfig;
+                typeConfig.typeName = typeName;
+                // 从 "ai_settings" 的全局默认值开始，如果特定类型没有定义，则使用全局默认
+                // 如果全局默认也没有，则使用World类中硬编码的m_defaultAI...值
+                typeConfig.baseHealth = configNode.value("base_health", aiSettings.value("default_base_health", m_defaultAIBaseHealth));
+                typeConfig.baseSpeed = configNode.value("base_speed", aiSettings.value("default_base_speed", m_defaultAITankSpeed));
+                typeConfig.baseAttack = configNode.value("base_attack", aiSettings.value("default_base_attack", m_defaultAIBaseAttack));
+                typeConfig.frameWidth = configNode.value("frame_width", aiSettings.value("default_frame_width", m_defaultAIFrameWidth));
+                typeConfig.frameHeight = configNode.value("frame_height", aiSettings.value("default_frame_height", m_defaultAIFrameHeight));
+                typeConfig.scoreValue = configNode.value("score_value", aiSettings.value("default_score_value", m_defaultAIScoreValue));
+                typeConfig.textureKey = configNode.value("texture_key", typeName); // 默认纹理键名与AI类型名一致
+                const std::string behavior = configNode.value("behavior", std::string("base"));
+                if (behavior == "hunter") {
+                    typeConfig.behavior = AIBehavior::HuntPlayer;
+                } else if (behavior != "base") {
+                    LOG_WARN("Warning: Unknown AI behavior '" << behavior << "' for type '" << typeName << "'. Using 'base'.");
+                }
+
+                m_aiTypeConfigs[typeName] = typeConfig;
+                m_availableAITankTypeNames.push_back(typeName);
+                LOG_INFO("Loaded AI Tank Config: " << typeName << " (HP:" << typeConfig.baseHealth << ", Speed:" << typeConfig.baseSpeed << ", Attack:" << typeConfig.baseAttack << ", Score:" << typeConfig.scoreValue << ")");
+            } catch (const nlohmann::json::exception& e) {
+                LOG_ERROR("Error parsing AI type config for '" << typeName << "': " << e.what());
+            }
+        }
+    } else {
+        LOG_WARN("Warning: 'ai_settings.ai_types' not found in config.json. No specific AI types loaded.");
+    }
+
+    if (m_availableAITankTypeNames.empty()) {
+        LOG_ERROR("CRITICAL: No AI tank types available to spawn! Check 'config.json' for 'ai_settings.ai_types'.");
+        // 此时游戏可能无法正常生成AI坦克
+    }
+}
+
+void World::initializeBulletPool(const nlohmann::json& config) {
+    // 从配置中读取子弹池参数 (bullet_pool)，缺省时使用 BulletPoolConfig 的默认值
+    BulletPoolConfig poolConfig;
+    if (config.contains("bullet_pool")) {
+        const auto& poolJson = config["bullet_pool"];
+        poolConfig.initialSize = poolJson.value("initial_size", poolConfig.initialSize);
+        poolConfig.maxSize = poolJson.value("max_size", poolConfig.maxSize);
+        poolConfig.growthStep = poolJson.value("growth_step", poolConfig.growthStep);
+        std::string growth = poolJson.value("growth", std::string("double"));
+        if (growth == "fixed") {
+            poolConfig.growth = BulletPoolGrowth::Fixed;
+        } else if (growth == "double") {
+            poolConfig.growth = BulletPoolGrowth::Double;
+        } else {
+            LOG_WARN("Warning: Unknown bullet_pool.growth '" << growth << "', using 'double'.");
+        }
+    }
+
+    // 各方向子弹的碰撞盒尺寸取自对应纹理 (无界面模式下纹理为空，保留默认尺寸)
+    const std::pair<Direction, const char*> bulletKeys[] = {
+            {Direction::UP, "bullet_up"}, {Direction::DOWN, "bullet_down"},
+            {Direction::LEFT, "bullet_left"}, {Direction::RIGHT, "bullet_right"}
+    };
+    for (const auto& [dir, key] : bulletKeys) {
+        m_bulletTextureHandles[static_cast<size_t>(dir)] = m_resources ? m_resources->findTexture(key) : INVALID_ASSET_HANDLE;
+        const TextureRegion& texture = getBulletTexture(dir);
+        if (texture.getSize().x > 0 && texture.getSize().y > 0) {
+            m_bullets.setHitboxSize(dir, sf::Vector2f(static_cast<float>(texture.getSize().x), static_cast<float>(texture.getSize().y)));
+        } else if (!isHeadless()) {
+            LOG_WARN("Warning: Bullet texture '" << key << "' is not loaded or invalid. Using default hitbox size.");
+        }
+    }
+
+    LOG_INFO("Pre-allocating bullet pool with " << poolConfig.initialSize << " bullets (max "
+              << poolConfig.maxSize << ", growth: " << (poolConfig.growth == BulletPoolGrowth::Fixed ? "fixed" : "double")
+              << ")...");
+    m_bullets.configure(poolConfig);
+    LOG_INFO("Bullet pool pre-allocated. Size: " << m_bullets.capacity());
+}
+
+void World::loadPathfindingConfig(const nlohmann::json& config) {
+    // 追击寻路的每tick预算 (pathfinding)，0 表示不限
+    int budgetMicros = 1000;
+    int maxRequestsPerTick = 0;
+    if (config.contains("pathfinding")) {
+        budgetMicros = config["pathfinding"].value("budget_us", budgetMicros);
+        maxRequestsPerTick = config["pathfinding"].value("max_requests_per_tick", maxRequestsPerTick);
+        m_useReservations = config["pathfinding"].value("reservations", m_useReservations);
+    }
+    m_pathRequests.configure(budgetMicros, maxRequestsPerTick);
+    LOG_INFO("Pathfinding budget: " << m_pathRequests.getBudgetMicros() << "us/tick, max "
+              << m_pathRequests.getMaxRequestsPerTick() << " requests/tick (0 = unlimited), reservations "
+              << (m_useReservations ? "on" : "off"));
+}
+
+void World::loadMapConfig(const nlohmann::json& config) {
+    // 地图尺寸 (格子数) 与分块换出参数 (map)，缺省时保持 Map 的默认尺寸
+    if (!config.contains("map")) return;
+    const auto& mapJson = config["map"];
+    m_map.setMapSize(mapJson.value("width", m_map.getMapWidth()), mapJson.value("height", m_map.getMapHeight()));
+    m_chunkKeepRadius = std::max(0, mapJson.value("chunk_keep_radius", m_chunkKeepRadius));
+    m_chunkResidencyInterval = std::max(0, mapJson.value("residency_interval_ticks", m_chunkResidencyInterval));
+    LOG_INFO("Map chunk residency: keep radius " << m_chunkKeepRadius << " chunks, every "
+              << m_chunkResidencyInterval << " ticks (0 = never page out)");
+}
+
+// =========================================================================
+// Getter 方法 - 资源访问
+// =========================================================================
+const TextureRegion& World::getTexture(const std::string& key) const {
+    if (m_resources) {
+        return m_resources->getTexture(key);
+    }
+    static TextureRegion emptyTexture; // 无界面模式：不持有任何纹理
+    return emptyTexture;
+}
+
+const TextureRegion& World::getTexture(TextureHandle handle) const {
+    if (m_resources) {
+        return m_resources->getTexture(handle);
+    }
+    static TextureRegion emptyTexture; // 无界面模式：不持有任何纹理
+    return emptyTexture;
+}
+
+TankTypeHandle World::findTankType(const std::string& tankType) const {
+    return m_resources ? m_resources->findTankType(tankType) : INVALID_ASSET_HANDLE;
+}
+
+const std::vector<TextureRegion>& World::getTankTextures(TankTypeHandle tankType, Direction dir) const {
+    if (m_resources) {
+        return m_resources->getTankTextures(tankType, dir);
+    }
+    static std::vector<TextureRegion> emptyTankTextures; // 无界面模式：没有动画帧
+    return emptyTankTextures;
+}
+
+// =========================================================================
+// Getter 方法 - 游戏状态与对象访问
+// =========================================================================
+bool World::spawnBullet(sf::Vector2f position, Direction direction, sf::Vector2f flyDirection,
+                        int damage, float speed, int type) {
+    // 追加到紧凑区末尾；容量不足时按配置的策略扩容，达到上限则拒绝
+    // 注意：动态扩展池可能会导致性能波动，最好预分配足够大的池 (见 config.json 的 bullet_pool)
+    return m_bullets.spawn(position, direction, flyDirection, damage, speed, type);
+}
+
+// =========================================================================
+// 碰撞处理方法
+// =========================================================================
+void World::resolveTankCollision(Tank* tank1, Tank* tank2) {
+    if (!tank1 || !tank2 || tank1->isDestroyed() || tank2->isDestroyed()) return;
+
+    sf::FloatRect bounds1 = tank1->getBounds();
+    sf::FloatRect bounds2 = tank2->getBounds();
+    sf::FloatRect intersection;
+
+    if (bounds1.intersects(bounds2, intersection)) {
+        sf::Vector2f pos1 = tank1->get_position();
+        sf::Vector2f pos2 = tank2->get_position();
+
+        sf::Vector2f pushDirection = pos1 - pos2; // 推离方向
+        if (pushDirection.x == 0.f && pushDirection.y == 0.f) { // 完全重叠
+            pushDirection = sf::Vector2f(0.f, -1.f); // 默认向上推开
+        }
+
+        float length = std::sqrt(pushDirection.x * pushDirection.x + pushDirection.y * pushDirection.y);
+        if (length != 0.f) {
+            pushDirection /= length; // 归一化
+        }
+
+        // 推开的幅度应略大于重叠深度的一半，以确保分开
+        float pushMagnitude = (std::min(intersection.width, intersection.height) / 2.0f) + 1.0f; // 增加一点余量
+        sf::Vector2f moveOffset = pushDirection * pushMagnitude;
+
+        // 尝试移动坦克，Tank::move会进行地图碰撞检测
+        tank1->move(pos1 + moveOffset, m_map);
+        tank2->move(pos2 - moveOffset, m_map);
+    }
+}
+
+void World::resolveTankToolCollision(Tank* tank, Tools* tool) {
+    if (!tank || tank->isDestroyed() || !tool || !tool->isActive()) {
+        return;
+    }
+    // 当前设计：任何坦克都可以拾取道具
+    LOG_DEBUG("Tank (type: " << tank->getTankType() << ") collided with tool. Applying effect.");
+    tool->applyEffect(*tank, *this); // 调用道具的 applyEffect
+    // 道具的 setActive(false) 应该在其 applyEffect 方法中调用来标记为已使用
+}
+
+// =========================================================================
+// 游戏对象生成与管理方法
+// =========================================================================
+void World::spawnRandomTool() {
+    if (m_availableToolTypes.empty()) {
+        return;
+    }
+    if (m_tools.size() >= 5) { // 限制屏幕上最多同时存在的道具数量
+        return;
+    }
+
+    std::uniform_int_distribution<> distribType(0, m_availableToolTypes.size() - 1);
+    std::string randomToolKey = m_availableToolTypes[distribType(m_rng)];
+
+    sf::Vector2f spawnPosition;
+    bool positionFound = false;
+    int maxAttempts = 100;
+    int tileW = m_map.getTileWidth();
+    int tileH = m_map.getTileHeight();
+
+    if (tileW <= 0 || tileH <= 0) {
+        LOG_ERROR("spawnRandomTool Error: Invalid tile dimensions from map (W:" << tileW << ", H:" << tileH << ").");
+        return;
+    }
+
+    for (int attempt = 0; attempt < maxAttempts; ++attempt) {
+        std::uniform_int_distribution<> distribX(1, m_map.getMapWidth() - 2);  // 避开最外层边界
+        std::uniform_int_distribution<> distribY(1, m_map.getMapHeight() - 2); // 避开最外层边界
+        int tileX = distribX(m_rng);
+        int tileY = distribY(m_rng);
+
+        if (m_map.isTileWalkable(tileX, tileY)) {
+            // 简单检查该位置是否已有道具 (基于瓦片中心)
+            sf::FloatRect newToolProspectiveBounds(
+                    static_cast<float>(tileX * tileW), static_cast<float>(tileY * tileH),
+                    static_cast<float>(tileW), static_cast<float>(tileH)
+            );
+            bool toolAlreadyThere = false;
+            for (const auto& existingTool : m_tools) {
+                if (existingTool && existingTool->isActive() && existingTool->getBound().intersects(newToolProspectiveBounds)) {
+                    toolAlreadyThere = true;
+                    break;
+                }
+            }
+            if (!toolAlreadyThere) {
+                spawnPosition = sf::Vector2f( // 道具放在瓦片中心
+                        static_cast<float>(tileX * tileW) + tileW / 2.0f,
+                        static_cast<float>(tileY * tileH) + tileH / 2.0f
+                );
+                positionFound = true;
+                break;
+            }
+        }
+    }
+
+    if (!positionFound) {
+        return;
+    }
+
+    const TextureRegion& toolTexture = getTexture(randomToolKey);
+    if (!isHeadless() && (toolTexture.getSize().x == 0 || toolTexture.getSize().y == 0)) {
+        LOG_ERROR("spawnRandomTool Error: Failed to get texture for tool key '" << randomToolKey << "'");
+        return;
+    }
+
+    std::unique_ptr<Tools> newTool = nullptr;
+    if (randomToolKey == "add_armor") newTool = std::make_unique<AddArmor>(spawnPosition, toolTexture);
+    else if (randomToolKey == "add_attack") newTool = std::make_unique<AddAttack>(spawnPosition, toolTexture);
+    else if (randomToolKey == "add_attack_speed") newTool = std::make_unique<AddAttackSpeed>(spawnPosition, toolTexture);
+    else if (randomToolKey == "add_speed") newTool = std::make_unique<AddSpeed>(spawnPosition, toolTexture);
+    else if (randomToolKey == "grenade") newTool = std::make_unique<GrenadeTool>(spawnPosition, toolTexture);
+    else if (randomToolKey == "slow_down_ai") newTool = std::make_unique<SlowDownAI>(spawnPosition, toolTexture);
+    else {
+        LOG_ERROR("spawnRandomTool Error: Unknown tool key '" << randomToolKey << "'");
+        return;
+    }
+
+    if (newTool) {
+        m_tools.push_back(std::move(newTool));
+        LOG_DEBUG("Spawned tool '" << randomToolKey << "' at (" << spawnPosition.x << ", " << spawnPosition.y << ")");
+    }
+}
+
+void World::updateTools(sf::Time dt) {
+    m_toolSpawnTimer += dt;
+    if (m_toolSpawnTimer >= m_toolSpawnInterval) {
+        spawnRandomTool();
+        m_toolSpawnTimer = sf::Time::Zero; // 重置计时器
+    }
+
+    for (auto& tool : m_tools) { // 更新所有活动道具 (例如生命周期)
+        if (tool && tool->isActive()) {
+            tool->update(dt);
+        }
+    }
+
+    // 处理坦克与道具的碰撞
+    for (auto& tankPtr : m_all_tanks) {
+        if (tankPtr && !tankPtr->isDestroyed()) {
+            for (auto& toolPtr : m_tools) {
+                if (toolPtr && toolPtr->isActive()) {
+                    if (tankPtr->getBounds().intersects(toolPtr->getBound())) {
+                        resolveTankToolCollision(tankPtr.get(), toolPtr.get());
+                        if (!toolPtr->isActive()) break; // 如果道具已失效，跳出内层循环
+                    }
+                }
+            }
+        }
+    }
+
+    // 清理不再活动的道具
+    m_tools.erase(std::remove_if(m_tools.begin(), m_tools.end(),
+                                 [](const std::unique_ptr<Tools>& t) {
+                                     return !t || !t->isActive();
+                                 }),
+                  m_tools.end());
+}
+
+void World::spawnNewAITank() {
+    int currentAICount = 0;
+    for (const AITank* aiTank : m_aiTanks) {
+        if (!aiTank->isDestroyed()) {
+            currentAICount++;
+        }
+    }
+    if (currentAICount >= m_maxActiveAITanks) {
+        return;
+    }
+
+    if (m_availableAITankTypeNames.empty()) {
+        LOG_ERROR("spawnNewAITank: No AI types loaded from config. Cannot spawn AI.");
+        return;
+    }
+
+    std::uniform_int_distribution<> distrib_type_idx(0, m_availableAITankTypeNames.size() - 1);
+    std::string selectedTypeName = m_availableAITankTypeNames[distrib_type_idx(m_rng)];
+
+    const AITankTypeConfig* selectedConfig = nullptr;
+    auto configIt = m_aiTypeConfigs.find(selectedTypeName);
+    if (configIt != m_aiTypeConfigs.end()) {
+        selectedConfig = &configIt->second;
+    } else {
+        LOG_ERROR("spawnNewAITank: Could not find config for selected AI type '" << selectedTypeName << "'. Aborting spawn.");
+        return;
+    }
+
+    sf::Vector2f spawnPosition;
+    bool positionFound = false;
+    int maxAttempts = 50;
+    int tileW = m_map.getTileWidth();
+    int tileH = m_map.getTileHeight();
+
+    if (tileW <= 0 || tileH <= 0) {
+        LOG_ERROR("spawnNewAITank Error: Invalid tile dimensions from map. Cannot determine spawn position.");
+        return;
+    }
+
+    // AI 出生区域：地图上半部分，避开边界
+    int minYTile = 1;
+    int maxYTile = std::max(minYTile + 1, m_map.getMapHeight() / 2); // 至少是 minYTile + 1
+    maxYTile = std::min(maxYTile, m_map.getMapHeight() - 2); // 不超过倒数第二行
+
+    for (int attempt = 0; attempt < maxAttempts; ++attempt) {
+        std::uniform_int_distribution<> distribX(1, m_map.getMapWidth() - 2);
+        std::uniform_int_distribution<> distribY(minYTile, maxYTile);
+        int tileX = distribX(m_rng);
+        int tileY = distribY(m_rng);
+
+        if (m_map.isTileWalkable(tileX, tileY)) {
+            sf::Vector2f prospectiveCenter(
+                    static_cast<float>(tileX * tileW) + tileW / 2.0f,
+                    static_cast<float>(tileY * tileH) + tileH / 2.0f
+            );
+            // 简单检查该位置是否已有坦克 (基于大致距离)
+            bool tankAlreadyThere = false;
+            float minDistanceSq = static_cast<float>((tileW * 0.9f) * (tileW * 0.9f)); // 坦克间最小距离平方
+            for (const auto& existingTank : m_all_tanks) {
+                if (existingTank && !existingTank->isDestroyed()) {
+                    sf::Vector2f diff = existingTank->get_position() - prospectiveCenter;
+                    if ((diff.x * diff.x + diff.y * diff.y) < minDistanceSq) {
+                        tankAlreadyThere = true;
+                        break;
+                    }
+                }
+            }
+            if (!tankAlreadyThere) {
+                spawnPosition = prospectiveCenter;
+                positionFound = true;
+                break;
+            }
+        }
+    }
+
+    if (!positionFound) {
+        return;
+    }
+
+    std::uniform_int_distribution<> distribDir(0, 3); // 与 Direction 枚举的 0-3 对应
+    Direction startDir = static_cast<Direction>(distribDir(m_rng));
+
+    auto newAITank = std::make_unique<AITank>(
+            spawnPosition, startDir, selectedConfig->typeName, *this,
+            selectedConfig->baseSpeed, selectedConfig->baseHealth, selectedConfig->baseAttack,
+            selectedConfig->frameWidth, selectedConfig->frameHeight, selectedConfig->scoreValue,
+            static_cast<unsigned int>(m_rng()) // 由世界随机数派生，固定种子时整局可复现
+    );
+
+    AITank* aiPtr = newAITank.get();
+    m_all_tanks.push_back(std::move(newAITank));
+    m_aiTanks.push_back(aiPtr);
+
+    if (aiPtr) {
+        aiPtr->setBehavior(selectedConfig->behavior);
+        sf::Vector2i baseTile = m_map.getBaseTileCoordinate();
+        if (baseTile.x != -1 && baseTile.y != -1) {
+            aiPtr->setStrategicTargetTile(baseTile);
+        } else {
+            LOG_ERROR("  spawnNewAITank: Could not set target for new AI tank (type: " << aiPtr->getTankType() << "): Base tile not found.");
+        }
+        LOG_DEBUG("Spawned AI Tank (type: " << aiPtr->getTankType() << ") at (" << spawnPosition.x << ", " << spawnPosition.y << "). "
+                  << (selectedConfig->behavior == AIBehavior::HuntPlayer ? "Hunting player." : "Target set to base."));
+    } else {
+        LOG_ERROR("spawnNewAITank: Failed to create new AITank instance for type '" << selectedConfig->typeName << "'.");
+    }
+}
+
+void World::updateAITankSpawning(sf::Time dt) {
+    m_aiTankSpawnTimer += dt;
+    if (m_aiTankSpawnTimer >= m_aiTankSpawnInterval) {
+        spawnNewAITank();
+        m_aiTankSpawnTimer = sf::Time::Zero; // 重置计时器
+    }
+}
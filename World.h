@@ -0,0 +1,215 @@
+#ifndef TANKS_WORLD_H
+#define TANKS_WORLD_H
+
+// =========================================================================
+// 必要的头文件包含
+// =========================================================================
+#include "heads.h"        // 项目通用头文件 (SFML, iostream, json, etc.)
+#include "Map.h"          // 地图类
+#include "tank.h"         // 坦克基类
+#include "BulletSystem.h" // 子弹 (SoA 存储)
+#include "common.h"       // 通用定义 (如 Direction 枚举)
+#include "AITank.h"       // AI坦克类
+#include "Tools.h"        // 道具基类
+#include "SpatialHash.h"  // 均匀网格空间哈希 (宽相碰撞)
+#include "FlowField.h"    // 通往基地的共享距离场 (AI寻路)
+#include "PathRequestQueue.h" // 追击寻路请求队列 (每tick时间预算)
+#include "ReservationTable.h" // AI之间的时空预留表 (协同寻路)
+#include "TextureAtlas.h"     // TextureRegion (图集子区域)
+#include "AssetRegistry.h"    // TextureHandle / TankTypeHandle
+#include "Profiler.h"         // 每个模拟阶段的耗时统计
+#include <array>
+#include <random>         // For std::mt19937
+
+// 前向声明 (Forward declarations)
+class PlayerTank;         // 玩家坦克类
+class ResourceManager;    // 纹理/配置资源 (无界面模式下为空)
+
+// AI坦克类型配置结构体
+struct AITankTypeConfig {
+    std::string typeName;
+    std::string textureKey;
+    float baseSpeed;
+    int baseHealth;
+    int baseAttack;
+    int frameWidth;
+    int frameHeight;
+    int scoreValue;
+    AIBehavior behavior = AIBehavior::AttackBase; // "behavior": "base" (默认) 或 "hunter"
+};
+
+// =========================================================================
+// World: 与窗口无关的游戏模拟核心
+// =========================================================================
+// 持有地图、坦克、子弹池、道具以及AI/道具生成器，step() 推进一次模拟。
+// 不依赖 sf::RenderWindow、字体或键盘；resources 为 nullptr 时即为无界面模式，
+// 所有纹理查询返回空纹理，碰撞尺寸改由帧尺寸/默认尺寸决定。
+class World {
+public:
+    // =========================================================================
+    // 构造与初始化
+    // =========================================================================
+    explicit World(const ResourceManager* resources = nullptr);
+    ~World();
+
+    bool init(const nlohmann::json& config); // 读取AI/道具/子弹池配置，确定地图尺寸，预分配子弹池
+    void reseed(unsigned int seed);          // 重新设定随机数种子 (批量对局时用于复现)
+    void setupLevel();                       // 清理实体，按当前关卡生成地图并放置玩家
+    bool advanceToNextLevel();               // 进入下一关；已是最后一关时返回 false
+    void resetMatch();                       // 分数清零并回到第一关
+
+    // =========================================================================
+    // 模拟推进
+    // =========================================================================
+    void step(sf::Time dt); // 推进一个固定步长的tick；界面层按固定频率调用，渲染在两次tick之间插值
+
+    // 玩家移动意图 (由输入层每tick设置，在 step 内按 dt 积分，保证移动与帧率无关)
+    void setPlayerMoveIntent(bool moving, Direction dir) { m_playerWantsToMove = moving; m_playerMoveDirection = dir; }
+
+    // 从子弹池发射一颗子弹 (返回 false 表示池已无法提供槽位)
+    bool spawnBullet(sf::Vector2f position, Direction direction, sf::Vector2f flyDirection,
+                     int damage, float speed, int type);
+
+    // 附加帧性能统计 (nullptr: 不计时)；step() 的各编号阶段累加到 profiler 的当前帧
+    void setProfiler(FrameProfiler* profiler) { m_profiler = profiler; }
+
+    // 覆盖 config.json 中的寻路预算 (无界面批量运行时关闭时间预算以保证结果可复现)
+    void configurePathBudget(int budgetMicros, int maxRequestsPerTick) { m_pathRequests.configure(budgetMicros, maxRequestsPerTick); }
+
+    // =========================================================================
+    // Getter 方法 - 游戏状态与对象访问
+    // =========================================================================
+    Map& getMap() { return m_map; }
+    const Map& getMap() const { return m_map; }
+    PlayerTank* getPlayerTank() const { return m_playerTankPtr; }
+    std::vector<std::unique_ptr<Tank>>& getAllTanksForModification() { return m_all_tanks; }
+    const std::vector<std::unique_ptr<Tank>>& getAllTanks() const { return m_all_tanks; }
+    const std::vector<AITank*>& getAITanks() const { return m_aiTanks; } // 仅AI坦克 (本tick被摧毁的在tick末移除)
+    const FlowField& getBaseFlowField() const { return m_baseFlowField; }
+    const PathRequestQueue& getPathRequests() const { return m_pathRequests; }
+    const ReservationTable& getReservations() const { return m_reservations; }
+    bool isCooperativePathfindingEnabled() const { return m_useReservations; }
+    const BulletSystem& getBullets() const { return m_bullets; }
+    const std::vector<std::unique_ptr<Tools>>& getTools() const { return m_tools; }
+
+    int getScore() const { return m_score; }
+    int getCurrentLevel() const { return m_currentLevel; }
+    bool isPlayerDestroyed() const { return m_playerTankPtr == nullptr; }
+    size_t getTankPairTestCount() const { return m_tankPairTests; } // 上一tick坦克间精确相交测试次数
+    size_t getBulletTankTestCount() const { return m_bulletTankTests; } // 上一tick子弹-坦克相交测试次数
+    size_t getTankCollisionCount() const { return m_tankCollisionsResolved; } // 上一tick需要推开的重叠坦克对数
+    bool shouldAdvanceLevel() const;
+
+    // =========================================================================
+    // Getter 方法 - 资源访问 (无界面模式下返回空纹理，不打印错误)
+    // =========================================================================
+    bool isHeadless() const { return m_resources == nullptr; }
+    const ResourceManager* getResources() const { return m_resources; }
+    const TextureRegion& getTexture(const std::string& key) const; // 按名字查找，仅用于初始化与低频路径
+    const TextureRegion& getTexture(TextureHandle handle) const;
+    TankTypeHandle findTankType(const std::string& tankType) const; // 实体创建时解析一次
+    const std::vector<TextureRegion>& getTankTextures(TankTypeHandle tankType, Direction dir) const;
+    const TextureRegion& getBulletTexture(Direction dir) const { return getTexture(m_bulletTextureHandles[static_cast<size_t>(dir)]); }
+
+    // =========================================================================
+    // 常量
+    // =========================================================================
+    static const int SCORE_THRESHOLD_LEVEL_2 = 200;
+    static const int SCORE_THRESHOLD_LEVEL_3 = 500;
+    static const int MAX_LEVEL = 3; // 最大关卡数
+
+private:
+    // =========================================================================
+    // 内部初始化与加载方法
+    // =========================================================================
+    void loadToolTypesFromConfig(const nlohmann::json& config);
+    void loadAITankConfigs(const nlohmann::json& config);
+    void initializeBulletPool(const nlohmann::json& config);
+    void loadPathfindingConfig(const nlohmann::json& config);
+    void loadMapConfig(const nlohmann::json& config);
+
+    // =========================================================================
+    // 碰撞处理方法
+    // =========================================================================
+    void resolveTankCollision(Tank* tank1, Tank* tank2);
+    void resolveTankToolCollision(Tank* tank, Tools* tool);
+
+    // =========================================================================
+    // 游戏对象生成与管理方法
+    // =========================================================================
+    void spawnRandomTool();
+    void updateTools(sf::Time dt);
+    void spawnNewAITank();
+    void updateAITankSpawning(sf::Time dt);
+
+    // =========================================================================
+    // 核心数据成员
+    // =========================================================================
+    const ResourceManager* m_resources;
+    Map m_map;
+    std::mt19937 m_rng; // 随机数生成器，用于地图生成等
+
+    // =========================================================================
+    // 游戏实体管理
+    // =========================================================================
+    std::vector<std::unique_ptr<Tank>> m_all_tanks;
+    PlayerTank* m_playerTankPtr;
+    std::vector<AITank*> m_aiTanks;      // m_all_tanks 中的 AI 坦克 (不拥有所有权)，供AI逻辑/计数/道具效果使用
+    SpatialHash m_tankGrid;              // 坦克宽相网格 (格子尺寸 = 瓦片尺寸，坦克碰撞与子弹命中前各重建一次)
+    std::vector<int> m_gridQueryResult;  // 查询结果缓冲，避免每次分配
+    size_t m_tankPairTests;              // 上一tick的坦克对测试次数 (性能统计)
+    size_t m_bulletTankTests;            // 上一tick的子弹-坦克测试次数 (性能统计)
+    size_t m_tankCollisionsResolved;     // 上一tick实际重叠、需要推开的坦克对数 (性能统计)
+    BulletSystem m_bullets;
+    std::array<TextureHandle, 4> m_bulletTextureHandles = { // 按 Direction 枚举顺序，初始化子弹池时解析
+            INVALID_ASSET_HANDLE, INVALID_ASSET_HANDLE, INVALID_ASSET_HANDLE, INVALID_ASSET_HANDLE};
+    std::vector<std::unique_ptr<Tools>> m_tools;
+    FlowField m_baseFlowField;           // 以基地为目标的共享流场 (每关重建，砖墙变化时增量更新)
+    PathRequestQueue m_pathRequests;     // 追击型AI的寻路请求 (按每tick预算分摊)
+    ReservationTable m_reservations;     // AI的时空预留 (每关按地图尺寸重建)
+    bool m_useReservations;              // config.json pathfinding.reservations (关闭时AI互不协调)
+    std::uint64_t m_tickCount;           // 已模拟的tick数 (寻路请求排队时长)
+    int m_chunkKeepRadius;               // config.json map.chunk_keep_radius：坦克周围保持完整存储的地图块半径
+    int m_chunkResidencyInterval;        // 每隔多少tick重新决定地图块换入/换出 (0: 从不换出)
+    std::vector<sf::Vector2i> m_activeTiles; // 换入/换出时所有坦克所在格 (复用缓冲)
+    FrameProfiler* m_profiler;           // 不拥有 (界面层或无界面入口持有)
+
+    // =========================================================================
+    // 游戏统计与状态
+    // =========================================================================
+    int m_score;
+    int m_currentLevel; // 当前关卡号，从1开始
+
+    // =========================================================================
+    // 玩家输入意图
+    // =========================================================================
+    bool m_playerWantsToMove;
+    Direction m_playerMoveDirection;
+
+    // =========================================================================
+    // 道具生成相关配置与状态
+    // =========================================================================
+    sf::Time m_toolSpawnInterval;
+    sf::Time m_toolSpawnTimer;
+    std::vector<std::string> m_availableToolTypes;
+
+    // =========================================================================
+    // AI坦克生成相关配置与状态
+    // =========================================================================
+    sf::Time m_aiTankSpawnInterval;
+    sf::Time m_aiTankSpawnTimer;
+    int m_maxActiveAITanks;
+    int m_configMaxActiveAITanks;         // 配置文件中的 max_active
+    sf::Time m_configAITankSpawnInterval; // 配置文件中的 spawn_interval_seconds
+    bool m_useLevelPresets;               // true: 按关卡使用内置AI数量/间隔；false: 始终使用配置值
+    std::map<std::string, AITankTypeConfig> m_aiTypeConfigs;
+    std::vector<std::string> m_availableAITankTypeNames;
+    float m_defaultAITankSpeed;
+    int m_defaultAIBaseHealth;
+    int m_defaultAIBaseAttack;
+    int m_defaultAIFrameWidth;
+    int m_defaultAIFrameHeight;
+    int m_defaultAIScoreValue;
+};
+
+#endif //TANKS_WORLD_H
@@ -0,0 +1,134 @@
+// bench_dispatch.cpp
+// 坦克类型分派基准：比较每tick按 dynamic_cast 区分AI坦克、按 TankKind 标记区分、
+// 以及直接遍历 AI 列表三种方式的开销。
+// 每个 "tick" 模拟 World::step 中原先使用 dynamic_cast 的三处：AI逻辑循环、
+// 击毁计分判断、spawnNewAITank 的AI计数。
+// 用法: TanksBenchDispatch [坦克数=500] [tick数=20000] [--config 路径]
+
+#include "World.h"
+#include "ResourceManager.h"
+#include "PlayerTank.h"
+#include "AITank.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace {
+
+// 防止编译器把基准循环整体优化掉
+volatile long long g_sink = 0;
+
+template <typename TickFn>
+double nanosecondsPerTick(int ticks, TickFn&& tick) {
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < ticks; ++t) {
+        g_sink = g_sink + tick();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds * 1e9 / ticks;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int tankCount = 500;
+    int ticks = 20000;
+    std::string configPath = "config.json";
+
+    int positional = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--config" && i + 1 < argc) { configPath = argv[++i]; continue; }
+        switch (positional++) {
+            case 0: tankCount = std::max(2, std::atoi(argv[i])); break;
+            case 1: ticks = std::max(1, std::atoi(argv[i])); break;
+            default: break;
+        }
+    }
+
+    // 坦克构造与配置加载的日志只保留警告与错误，不干扰基准输出
+    Logger::instance().setLevel(LogLevel::Warn);
+
+    ResourceManager resources;
+    if (!resources.loadConfig(configPath, false)) {
+        std::cerr << "CRITICAL ERROR: Failed to load '" << configPath << "' for benchmark." << std::endl;
+        return -1;
+    }
+
+    World world; // 无界面模式，只为坦克构造提供 World&
+    if (!world.init(resources.getConfig())) {
+        std::cerr << "CRITICAL ERROR: Failed to initialize headless world." << std::endl;
+        return -1;
+    }
+
+    // 1 个玩家 + (tankCount - 1) 个AI，打乱顺序使类型分布与实际对局相似
+    std::mt19937 rng(1);
+    std::vector<std::unique_ptr<Tank>> tanks;
+    tanks.push_back(std::make_unique<PlayerTank>(sf::Vector2f(0.f, 0.f), Direction::UP, world));
+    for (int i = 1; i < tankCount; ++i) {
+        tanks.push_back(std::make_unique<AITank>(sf::Vector2f(0.f, 0.f), Direction::DOWN, "ai_default", world,
+                                                 30.f, 80, 15, 50, 50, 100, static_cast<unsigned int>(rng())));
+    }
+    std::shuffle(tanks.begin(), tanks.end(), rng);
+
+    std::vector<AITank*> aiTanks;
+    for (const auto& tank : tanks) {
+        if (tank->isAI()) aiTanks.push_back(static_cast<AITank*>(tank.get()));
+    }
+    Logger::instance().flush(); // 构造期间的警告先写完，避免与结果交错
+
+    // 旧做法：每处都对全部坦克做 dynamic_cast
+    double castNs = nanosecondsPerTick(ticks, [&]() {
+        long long acc = 0;
+        for (const auto& tank : tanks) {                       // AI逻辑循环
+            if (AITank* ai = dynamic_cast<AITank*>(tank.get())) acc += ai->isMoving();
+        }
+        for (const auto& tank : tanks) {                       // 计分判断
+            if (AITank* ai = dynamic_cast<AITank*>(tank.get())) acc += ai->getScoreValue();
+        }
+        for (const auto& tank : tanks) {                       // AI计数
+            if (dynamic_cast<AITank*>(tank.get()) && !tank->isDestroyed()) ++acc;
+        }
+        return acc;
+    });
+
+    // 类型标记：仍遍历全部坦克，但只比较一个字节
+    double tagNs = nanosecondsPerTick(ticks, [&]() {
+        long long acc = 0;
+        for (const auto& tank : tanks) {
+            if (tank->isAI()) acc += static_cast<AITank*>(tank.get())->isMoving();
+        }
+        for (const auto& tank : tanks) {
+            if (tank->isAI()) acc += tank->getScoreValue();
+        }
+        for (const auto& tank : tanks) {
+            if (tank->isAI() && !tank->isDestroyed()) ++acc;
+        }
+        return acc;
+    });
+
+    // 当前做法：AI逻辑与计数遍历 AI 列表，计分用类型标记
+    double listNs = nanosecondsPerTick(ticks, [&]() {
+        long long acc = 0;
+        for (AITank* ai : aiTanks) acc += ai->isMoving();
+        for (const auto& tank : tanks) {
+            if (tank->isAI()) acc += tank->getScoreValue();
+        }
+        for (AITank* ai : aiTanks) {
+            if (!ai->isDestroyed()) ++acc;
+        }
+        return acc;
+    });
+
+    std::cout << tankCount << " tanks, " << ticks << " ticks" << std::endl;
+    std::cout << std::fixed << std::setprecision(1)
+              << "  dynamic_cast : " << castNs << " ns/tick" << std::endl
+              << "  kind tag     : " << tagNs << " ns/tick (" << (tagNs > 0.0 ? castNs / tagNs : 0.0) << "x)" << std::endl
+              << "  AI list + tag: " << listNs << " ns/tick (" << (listNs > 0.0 ? castNs / listNs : 0.0) << "x)" << std::endl;
+    return 0;
+}
@@ -2,14 +2,11 @@
 #define TANKS_GAME_H
 
 // 统一包含所有必要的头文件
-#include "heads.h"        // 项目通用头文件 (SFML, iostream, json, etc.)
-#include "Map.h"          // 地图类
-#include "tank.h"         // 坦克基类
-#include "Bullet.h"       // 子弹类
-#include "common.h"       // 通用定义 (如 Direction 枚举)
-#include "AITank.h"       // AI坦克类
-#include "Tools.h"        // 道具基类
-#include <random>         // For std::mt19937
+#include "heads.h"            // 项目通用头文件 (SFML, iostream, json, etc.)
+#include "World.h"            // 与窗口无关的模拟核心
+#include "ResourceManager.h"  // 配置与纹理资源
+#include "SpriteBatch.h"      // 动态实体的批量绘制
+#include "Profiler.h"         // 每帧各阶段耗时
 
 // 前向声明 (Forward declarations)
 class PlayerTank; // 玩家坦克类
@@ -23,18 +20,6 @@ enum class GameState {
     // Settings, Playing2P 等可以保留用于未来扩展
 };
 
-// AI坦克类型配置结构体 (保持不变)
-struct AITankTypeConfig {
-    std::string typeName;
-    std::string textureKey;
-    float baseSpeed;
-    int baseHealth;
-    int baseAttack;
-    int frameWidth;
-    int frameHeight;
-    int scoreValue;
-};
-
 class Game {
 public:
     // =========================================================================
@@ -49,81 +34,87 @@ public:
     void init();
     void run();
     void end();
+    // 立即开始记录 Chrome trace (在 init() 之前调用可覆盖配置加载与首关布局)；
+    // dumpAfterFrames 帧后自动写出，0 表示直到再次按 F4 或退出时写出
+    void startTrace(std::uint64_t dumpAfterFrames);
 
     // =========================================================================
     // Getter 方法 - 游戏状态与对象访问
     // =========================================================================
     bool isWindowOpen() const { return window.isOpen(); }
-    Map& getMap() { return m_map; }
-    const Map& getMap() const { return m_map; }
-    PlayerTank* getPlayerTank() const { return m_playerTankPtr; }
-    std::vector<std::unique_ptr<Tank>>& getAllTanksForModification() { return m_all_tanks; }
-    Bullet* getAvailableBullet();
-    int getCurrentLevel() const { return m_currentLevel; } // 获取当前关卡
-
-    // =========================================================================
-    // Getter 方法 - 资源访问
-    // =========================================================================
-    const sf::Texture& getTexture(const std::string& key) const;
-    const std::vector<sf::Texture>& getTankTextures(const std::string& tankType, Direction dir) const;
+    World& getWorld() { return m_world; }
+    int getCurrentLevel() const { return m_world.getCurrentLevel(); } // 获取当前关卡
 
 private:
     // =========================================================================
     // 内部核心逻辑方法
     // =========================================================================
-    void Handling_events(sf::Time dt);
-    void update(sf::Time dt);
-    void render();
+    void Handling_events();                    // 处理窗口事件，记录玩家移动意图
+    void updateMessageTimer(sf::Time frameDt); // 关卡提示计时 (按真实帧时间)
+    void update(sf::Time dt);                  // 推进一个固定步长的模拟tick
+    void render(float alpha);                  // alpha: 上一tick到当前tick之间的插值系数
+    void updateCamera(float alpha);            // 摄像机跟随玩家 (插值位置)，并限制在地图范围内
+    sf::FloatRect getVisibleWorldRect() const; // 当前摄像机看到的世界矩形 (像素)，用于绘制剔除
+    void loadProfilerConfig(const nlohmann::json& config);
+    void drawProfilerOverlay(float x, float y); // 右侧UI面板中的阶段耗时 (平均/p99)
+    void dumpTrace();                           // 写出 trace 并停止记录
 
     // =========================================================================
-    // 内部初始化与加载方法
+    // 关卡流程 (模拟部分委托给 World，这里只负责界面状态与提示文字)
     // =========================================================================
-    bool loadConfig(const std::string& configPath);
-    bool loadTextureFromJson(const std::string& key, const std::string& path);
-    void loadToolTypesFromConfig();
-    void loadAITankConfigs();
-    void initializeBulletPool();
     void setupLevel(); // 修改：用于设置或重置当前关卡
     void advanceToNextLevel(); // 新增：进入下一关的逻辑
+    void showCenterMessage(const std::string& message, sf::Time duration);
+    GameState getCurrentState() const { return state; }
 
     // =========================================================================
-    // 碰撞处理方法 (保持不变)
+    // 核心游戏数据成员
     // =========================================================================
-    void resolveTankCollision(Tank* tank1, Tank* tank2);
-    void resolveTankToolCollision(Tank* tank, Tools* tool);
+    sf::RenderWindow window;
+    GameState state;
+    ResourceManager m_resources; // 必须先于 m_world 构造
+    World m_world;
+    sf::Clock clock;
 
     // =========================================================================
-    // 游戏对象生成与管理方法 (保持不变)
+    // 固定步长模拟
     // =========================================================================
-    void spawnRandomTool();
-    void updateTools(sf::Time dt);
-    void spawnNewAITank();
-    void updateAITankSpawning(sf::Time dt);
-    GameState getCurrentState() const { return state; }
+    sf::Time m_timeStep;        // 每个模拟tick的时长 (默认 1/120 秒)
+    int m_maxCatchUpSteps;      // 单帧最多补算的tick数
+    sf::Time m_accumulator;     // 尚未模拟的真实时间
 
     // =========================================================================
-    // 核心游戏数据成员
+    // 摄像机 (游戏区域跟随玩家；右侧UI面板使用窗口默认视图)
     // =========================================================================
-    sf::RenderWindow window;
-    GameState state;
-    Map m_map;
-    sf::Clock clock;
-    std::mt19937 m_rng; // 随机数生成器，用于地图生成等
+    sf::View m_worldView;
+    sf::Vector2f m_cameraCenter; // 玩家被摧毁后保持最后的位置
+    static constexpr float GAME_AREA_WIDTH = 1200.f; // 窗口左侧的游戏区域 (像素)，右侧为UI面板
 
     // =========================================================================
-    // 游戏实体管理 (保持不变)
+    // 批量绘制 (坦克、子弹、道具；顶点缓冲跨帧复用)
     // =========================================================================
-    std::vector<std::unique_ptr<Tank>> m_all_tanks;
-    PlayerTank* m_playerTankPtr;
-    std::vector<std::unique_ptr<Bullet>> m_bulletPool;
-    std::vector<std::unique_ptr<Tools>> m_tools;
+    SpriteBatch m_spriteBatch;
 
     // =========================================================================
-    // 资源缓存与配置 (保持不变)
+    // 帧性能统计 (F3 切换显示；退出时写出 CSV)
+    // =========================================================================
+    FrameProfiler m_profiler;
+    bool m_showProfiler;
+    size_t m_profilerWindowFrames;  // 平均值/p99 统计的最近帧数
+    std::string m_profilerCsvPath;  // 为空时不写出
+    int m_profilerRefreshCountdown; // 叠加文字每隔若干帧刷新一次
+    sf::Text m_profilerText;
+
+    // =========================================================================
+    // Chrome trace 记录 (F4 开始/写出；缓冲在开始记录时一次性分配)
+    // =========================================================================
+    std::string m_tracePath;            // config.json profiler.trace_path
+    std::uint64_t m_traceDumpFrame;     // 到达该帧号时自动写出 (0: 不自动写出)
+    static constexpr size_t TRACE_MAX_EVENTS = 1 << 18; // 约 8MB，60fps 下可记录两分钟左右
+
+    // =========================================================================
+    // UI 资源
     // =========================================================================
-    nlohmann::json m_configJson;
-    std::map<std::string, sf::Texture> m_textureCache;
-    std::map<std::string, std::map<Direction, std::vector<sf::Texture>>> m_tankTextureCache;
     sf::Font m_uiFont;
 
     // =========================================================================
@@ -141,45 +132,6 @@ private:
     sf::Text m_currentLevelText;      // 新增：显示当前关卡
     sf::Text m_levelTransitionMessageText; // 新增：显示 "Level X" 或 "Prepare for next level"
     sf::Time m_levelTransitionDisplayTimer; // 新增：控制关卡切换信息显示时间
-
-    // =========================================================================
-    // 游戏统计与状态
-    // =========================================================================
-    int score;
-    // int life; // 保留，如果需要生命机制
-    int m_currentLevel; // 新增：当前关卡号，从1开始
-
-    // =========================================================================
-    // 道具生成相关配置与状态 (保持不变)
-    // =========================================================================
-    sf::Time m_toolSpawnInterval;
-    sf::Time m_toolSpawnTimer;
-    std::vector<std::string> m_availableToolTypes;
-
-    // =========================================================================
-    // AI坦克生成相关配置与状态 (保持不变)
-    // =========================================================================
-    sf::Time m_aiTankSpawnInterval;
-    sf::Time m_aiTankSpawnTimer;
-    int m_maxActiveAITanks;
-    std::map<std::string, AITankTypeConfig> m_aiTypeConfigs;
-    std::vector<std::string> m_availableAITankTypeNames;
-    float m_defaultAITankSpeed;
-    int m_defaultAIBaseHealth;
-    int m_defaultAIBaseAttack;
-    int m_defaultAIFrameWidth;
-    int m_defaultAIFrameHeight;
-    int m_defaultAIScoreValue;
-
-    // =========================================================================
-    // 常量
-    // =========================================================================
-    const size_t INITIAL_BULLET_POOL_SIZE = 100;
-    // 新增：关卡分数阈值
-    static const int SCORE_THRESHOLD_LEVEL_2 = 200;
-    static const int SCORE_THRESHOLD_LEVEL_3 = 500; // 总分达到5000进入第三关 (2000 for L2 + 3000 more)
-    // 或者你可以设定为每关独立的增量分数
-    static const int MAX_LEVEL = 3; // 最大关卡数
 };
 
 #endif //TANKS_GAME_H
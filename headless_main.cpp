@@ -0,0 +1,175 @@
+// headless_main.cpp
+// 无界面模拟入口：不创建窗口、不加载任何纹理，批量运行对局用于性能测试与回归。
+// 用法: TanksHeadless [对局数=10] [每局最长秒数=300] [步长毫秒=8.333] [--config 路径 | --pack 资源包] [--verbose]
+//                     [--path-budget-us N] (默认 0：不限寻路时间预算，保证结果与机器速度无关)
+//                     [--trace 路径 [--trace-events N]] 记录 Chrome trace (含配置加载与地图生成)，结束时写出
+
+#include "World.h"
+#include "ResourceManager.h"
+#include "PlayerTank.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    int matches = 10;
+    float maxSeconds = 300.f;
+    float dtMillis = 1000.f / 120.f; // 与游戏默认的 120Hz 固定步长一致
+    bool verbose = false;
+    std::string configPath = "config.json"; // 压力测试可指定另一份配置 (例如更多AI坦克)
+    std::string packPath;                   // 非空时改为读取资源包中嵌入的配置
+    int pathBudgetMicros = 0;               // 寻路时间预算依赖机器速度，默认关闭以便复现
+    std::string tracePath;                  // 非空时记录 trace；缓冲写满后只丢弃新事件
+    size_t traceEvents = 1 << 20;
+
+    int positional = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--verbose") { verbose = true; continue; }
+        if (arg == "--config" && i + 1 < argc) { configPath = argv[++i]; continue; }
+        if (arg == "--pack" && i + 1 < argc) { packPath = argv[++i]; continue; }
+        if (arg == "--path-budget-us" && i + 1 < argc) { pathBudgetMicros = std::max(0, std::atoi(argv[++i])); continue; }
+        if (arg == "--trace" && i + 1 < argc) { tracePath = argv[++i]; continue; }
+        if (arg == "--trace-events" && i + 1 < argc) { traceEvents = static_cast<size_t>(std::max(1LL, std::atoll(argv[++i]))); continue; }
+        switch (positional++) {
+            case 0: matches = std::max(1, std::atoi(argv[i])); break;
+            case 1: maxSeconds = static_cast<float>(std::atof(argv[i])); break;
+            case 2: dtMillis = static_cast<float>(std::atof(argv[i])); break;
+            default: break;
+        }
+    }
+
+    // 模拟过程中的大量调试日志会严重拖慢批量运行，默认只保留警告与错误
+    Logger::instance().setLevel(verbose ? LogLevel::Debug : LogLevel::Warn);
+    if (!tracePath.empty()) TraceRecorder::instance().start(traceEvents);
+
+    // 只解析配置，不加载纹理
+    ResourceManager resources;
+    const bool configLoaded = packPath.empty() ? resources.loadConfig(configPath, false) : resources.loadPack(packPath, false);
+    if (!configLoaded) {
+        std::cerr << "CRITICAL ERROR: Failed to load '" << (packPath.empty() ? configPath : packPath) << "' for headless run." << std::endl;
+        return -1;
+    }
+
+    World world; // resources 为空：无界面模式
+    if (!world.init(resources.getConfig())) {
+        std::cerr << "CRITICAL ERROR: Failed to initialize headless world." << std::endl;
+        return -1;
+    }
+    world.configurePathBudget(pathBudgetMicros, world.getPathRequests().getMaxRequestsPerTick());
+    FrameProfiler profiler; // 无界面模式下每个tick算一帧
+    world.setProfiler(&profiler);
+
+    const sf::Time dt = sf::seconds(dtMillis / 1000.f);
+    const long long maxTicks = static_cast<long long>(maxSeconds * 1000.f / dtMillis);
+    long long totalTicks = 0;
+    unsigned long long totalPairTests = 0;
+    unsigned long long totalBulletTests = 0;
+    unsigned long long totalTankCollisions = 0;
+    double totalWallSeconds = 0.0;
+
+    for (int match = 0; match < matches; ++match) {
+        world.reseed(static_cast<unsigned int>(match + 1)); // 每局固定种子，结果可复现
+        world.resetMatch();
+
+        const char* outcome = "timeout";
+        long long ticks = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (; ticks < maxTicks; ++ticks) {
+            // 无人操控的玩家：原地持续开火
+            PlayerTank* player = world.getPlayerTank();
+            if (player && !player->isDestroyed() && player->canShoot()) {
+                player->shoot(world);
+            }
+
+            world.step(dt);
+            profiler.endFrame();
+            totalPairTests += world.getTankPairTestCount();
+            totalBulletTests += world.getBulletTankTestCount();
+            totalTankCollisions += world.getTankCollisionCount();
+
+            if (world.isPlayerDestroyed()) { outcome = "player_destroyed"; break; }
+            if (world.getMap().isBaseDestroyed()) { outcome = "base_destroyed"; break; }
+            if (world.shouldAdvanceLevel() && !world.advanceToNextLevel()) { outcome = "won"; break; }
+        }
+        double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        totalTicks += ticks;
+        totalWallSeconds += wallSeconds;
+
+        Logger::instance().flush(); // 先写完本局日志，避免与报告交错
+        std::cout << "match " << match + 1 << ": " << outcome
+                  << " level=" << world.getCurrentLevel()
+                  << " score=" << world.getScore()
+                  << " ticks=" << ticks
+                  << " ticks/s=" << std::fixed << std::setprecision(0) << (wallSeconds > 0.0 ? ticks / wallSeconds : 0.0)
+                  << std::endl;
+    }
+
+    std::cout << "total: " << matches << " matches, " << totalTicks << " ticks in "
+              << std::setprecision(3) << totalWallSeconds << "s ("
+              << std::setprecision(0) << (totalWallSeconds > 0.0 ? totalTicks / totalWallSeconds : 0.0)
+              << " ticks/s), tank pair tests/tick: "
+              << std::setprecision(1) << (totalTicks > 0 ? static_cast<double>(totalPairTests) / totalTicks : 0.0)
+              << ", bullet-tank tests/tick: "
+              << (totalTicks > 0 ? static_cast<double>(totalBulletTests) / totalTicks : 0.0)
+              << ", tank collisions resolved/tick: " << std::setprecision(2)
+              << (totalTicks > 0 ? static_cast<double>(totalTankCollisions) / totalTicks : 0.0)
+              << std::endl;
+
+    std::cout << "phase times per tick (last " << profiler.getStoredFrameCount() << " ticks, avg/p99 us):";
+    for (size_t phase = 0; phase < static_cast<size_t>(ProfilePhase::RenderMap); ++phase) { // 渲染阶段在无界面模式下不存在
+        const FrameProfiler::PhaseStats stats = profiler.getStats(static_cast<ProfilePhase>(phase), profiler.getStoredFrameCount());
+        std::cout << " " << getProfilePhaseName(static_cast<ProfilePhase>(phase)) << " " << std::setprecision(2)
+                  << stats.averageMicros << "/" << stats.p99Micros;
+    }
+    std::cout << std::endl;
+
+    if (!tracePath.empty()) {
+        TraceRecorder& tracer = TraceRecorder::instance();
+        tracer.stop();
+        tracer.writeJson(tracePath);
+        Logger::instance().flush();
+        std::cout << "trace: " << tracer.getEventCount() << " events, " << tracer.getDroppedCount()
+                  << " dropped -> " << tracePath << std::endl;
+    }
+
+    const BulletSystem& bullets = world.getBullets();
+    const BulletPoolStats& poolStats = bullets.getStats();
+    std::cout << "bullet pool: capacity " << bullets.capacity() << "/" << bullets.getConfig().maxSize
+              << ", high-water " << poolStats.highWaterMark
+              << ", growth events " << poolStats.growthEvents
+              << ", rejected spawns " << poolStats.rejectedSpawns << std::endl;
+
+    const TileChunkGrid& tileGrid = world.getMap().getTileGrid();
+    std::cout << "map " << world.getMap().getMapWidth() << "x" << world.getMap().getMapHeight()
+              << ": chunks resident " << tileGrid.getResidentChunkCount()
+              << ", compact " << tileGrid.getCompactChunkCount()
+              << ", empty " << tileGrid.getEmptyChunkCount()
+              << ", tile memory " << tileGrid.getTileMemoryBytes() / 1024 << " KiB" << std::endl;
+
+    const FlowField& flowField = world.getBaseFlowField();
+    std::cout << "base flow field: full rebuilds " << flowField.getFullRebuildCount()
+              << ", incremental updates " << flowField.getIncrementalUpdateCount() << std::endl;
+
+    const PathRequestQueue& pathRequests = world.getPathRequests();
+    const PathQueueStats& pathStats = pathRequests.getStats();
+    std::cout << "path requests (budget " << pathRequests.getBudgetMicros() << "us/tick): processed " << pathStats.processed
+              << ", avg " << std::setprecision(2) << (pathStats.processed > 0 ? pathStats.totalMicros / pathStats.processed : 0.0)
+              << "us, max/tick " << std::setprecision(1) << pathStats.maxTickMicros
+              << "us, deferred ticks " << pathStats.deferredTicks
+              << ", max wait " << pathStats.maxWaitTicks << " ticks" << std::endl;
+
+    if (world.isCooperativePathfindingEnabled()) {
+        const ReservationTable& reservations = world.getReservations();
+        std::cout << "reservations: window plans " << reservations.getPlanCount()
+                  << ", waits " << reservations.getWaitCount()
+                  << ", expansions/plan " << std::setprecision(1)
+                  << (reservations.getPlanCount() > 0 ? static_cast<double>(reservations.getExpansionCount()) / reservations.getPlanCount() : 0.0)
+                  << std::endl;
+    }
+    return 0;
+}
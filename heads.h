@@ -13,11 +13,14 @@
 #include "fstream"
 #include "ctime"
 #include "cstdlib"
+#ifdef _WIN32
 #include "windows.h"
+#endif
 #include <SFML/Graphics.hpp>
 #include <stdexcept>
 #include <memory>
 #include "nlohmann/json.hpp"
+#include "Log.h" // LOG_DEBUG / LOG_INFO / LOG_WARN / LOG_ERROR (异步日志)
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -1,15 +1,25 @@
 // main.cpp
-#include "Game.h" // 假设你的Game类定义在Game.h中
+#include "game.h" // Game类定义在game.h中
 #include <iostream>
+#include <cstdlib>
+#include <string>
 
-int main() {
+// 用法: Tanks [--trace [帧数]]  从启动开始记录 Chrome trace，帧数>0 时到达后自动写出 (否则按 F4 或退出时写出)
+int main(int argc, char* argv[]) {
     Game game; // 创建 Game 对象，构造函数会被调用
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--trace") {
+            const long long frames = (i + 1 < argc) ? std::atoll(argv[i + 1]) : 0;
+            if (frames > 0) ++i;
+            game.startTrace(static_cast<std::uint64_t>(frames));
+        }
+    }
     game.init(); // Game的构造函数现在调用init，所以这里不需要显式调用（除非你改了逻辑）
 
     if (game.isWindowOpen()) { // 假设你给Game类加一个isWindowOpen()方法，或者直接在run里判断
         game.run(); // 启动游戏主循环
     } else {
-        std::cerr << "Failed to initialize the game or window could not be opened." << std::endl;
+        LOG_ERROR("Failed to initialize the game or window could not be opened.");
         return -1;
     }
     return 0;
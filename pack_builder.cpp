@@ -0,0 +1,26 @@
+// pack_builder.cpp
+// 资源包生成器：读取 config.json，解码其中引用的所有图片，在CPU上打包图集，
+// 把配置与图集页像素写入一个二进制资源包。游戏启动时优先内存映射该资源包，
+// 不再依赖配置中的图片路径，也省去了 JSON 之外的全部 PNG 解码。
+// 用法: TanksPackBuilder [配置路径=config.json] [输出路径=assets.pack]
+
+#include "ResourceManager.h"
+
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    const std::string configPath = argc > 1 ? argv[1] : "config.json";
+    const std::string packPath = argc > 2 ? argv[2] : "assets.pack";
+
+    ResourceManager resources;
+    if (!resources.loadConfig(configPath, false)) { // 不创建纹理，生成器无需图形上下文
+        std::cerr << "CRITICAL ERROR: Failed to load '" << configPath << "' for pack building." << std::endl;
+        return -1;
+    }
+    if (!resources.writePack(packPath)) {
+        std::cerr << "CRITICAL ERROR: Failed to write asset pack '" << packPath << "'." << std::endl;
+        return -1;
+    }
+    return 0;
+}
@@ -1,17 +1,20 @@
 // Tank.cpp
 #include <iostream>
 #include "tank.h"
-#include "Bullet.h"
-#include "Game.h" // Make sure Game.h is included for Game&
+#include "BulletSystem.h"
+#include "World.h" // World& 提供纹理、地图与子弹池
+#include "SpriteBatch.h"
 
 const int Tank::MAX_ARMOR;
 // MODIFIED Constructor
-Tank::Tank(sf::Vector2f startPosition, Direction startDirection, const std::string& tankType, Game& game,
-           float speed, int frameWidth, int frameHeight, int iniHealth, int armor,int scoreValue = 0) :
+Tank::Tank(sf::Vector2f startPosition, Direction startDirection, const std::string& tankType, World& world,
+           float speed, int frameWidth, int frameHeight, int iniHealth, int armor, int scoreValue, TankKind kind) :
         m_position(startPosition),
+        m_prevPosition(startPosition),
         m_direction(startDirection),
         m_tankType(tankType), // Store the tank type
         m_currentFrame(0),
+        m_animationTimer(sf::Time::Zero),
         m_frameWidth(frameWidth),
         m_frameHeight(frameHeight),
         m_baseShootCooldown(sf::seconds(0.5f)), // Example value
@@ -34,34 +37,37 @@ Tank::Tank(sf::Vector2f startPosition, Direction startDirection, const std::stri
         m_movementSpeedBuffDuration(sf::Time::Zero),
         m_originalSpeed(speed),
         m_isInForest(false),
-        m_scoreValue(scoreValue)
+        m_scoreValue(scoreValue),
+        m_kind(kind),
+        m_tankTypeHandle(world.findTankType(tankType)) // 只在构造时按名字查找一次
 {
     // Textures are no longer loaded by a Tank::loadTextures() method.
-    // Instead, we fetch the initial texture from the Game object.
-    const auto& initialFrames = game.getTankTextures(m_tankType, m_direction);
+    // Instead, we fetch the initial texture from the World object.
+    const auto& initialFrames = world.getTankTextures(m_tankTypeHandle, m_direction);
     if (!initialFrames.empty()) {
-        m_sprite.setTexture(initialFrames[0]); // Set initial texture (first frame)
-    } else {
-        std::cerr << "Tank Constructor Error: Initial texture could not be set for tank type '"
+        initialFrames[0].applyTo(m_sprite); // Set initial texture (first frame, atlas sub-rect)
+    } else if (!world.isHeadless()) {
+        LOG_ERROR("Tank Constructor Error: Initial texture could not be set for tank type '"
                   << m_tankType << "' and direction " << static_cast<int>(m_direction)
-                  << ". Textures not found or empty in Game cache." << std::endl;
+                  << ". Textures not found or empty in Game cache.");
         // Consider loading a default/error texture or handling this error more gracefully
     }
 
     if (m_frameWidth > 0 && m_frameHeight > 0) {
         m_sprite.setOrigin(m_frameWidth / 2.f, m_frameHeight / 2.f);
     } else {
-        std::cerr << "Tank Constructor Error: Frame width or height is zero for tank type '" << m_tankType << "'." << std::endl;
+        LOG_ERROR("Tank Constructor Error: Frame width or height is zero for tank type '" << m_tankType << "'.");
     }
     m_originalSpeed = m_baseSpeed;
     m_sprite.setPosition(m_position);
-    std::cout << "Tank type '" << m_tankType << "' created." << std::endl;
+    LOG_DEBUG("Tank type '" << m_tankType << "' created.");
 }
 
 // loadTextures() method is REMOVED from here. It's now handled by the Game class loading from JSON.
 
-void Tank::draw(sf::RenderWindow& window) {
-    window.draw(m_sprite);
+void Tank::draw(SpriteBatch& batch, float alpha) {
+    m_sprite.setPosition(getInterpolatedPosition(alpha)); // 在上一tick与当前tick之间插值，平滑固定步长带来的抖动
+    batch.add(m_sprite);
 
     // Debug drawing for center point (optional)
     // sf::CircleShape centerDot(3.f);
@@ -71,31 +77,37 @@ void Tank::draw(sf::RenderWindow& window) {
     // window.draw(centerDot);
 }
 
-// MODIFIED setDirection to use textures from Game
-void Tank::setDirection(Direction dir, Game& game) {
+// MODIFIED setDirection to use textures from World
+void Tank::setDirection(Direction dir, World& world) {
     if (m_direction != dir) {
         m_direction = dir;
         m_currentFrame = 0; // Reset animation frame
+        m_animationTimer = sf::Time::Zero;
 
-        const auto& frames = game.getTankTextures(m_tankType, m_direction);
+        const auto& frames = world.getTankTextures(m_tankTypeHandle, m_direction);
         if (!frames.empty()) {
-            m_sprite.setTexture(frames[m_currentFrame]);
-        } else {
-            std::cerr << "Tank::setDirection Error: Texture not found for tank type '"
-                      << m_tankType << "' and direction " << static_cast<int>(m_direction) << std::endl;
+            frames[m_currentFrame].applyTo(m_sprite);
+        } else if (!world.isHeadless()) {
+            LOG_ERROR("Tank::setDirection Error: Texture not found for tank type '"
+                      << m_tankType << "' and direction " << static_cast<int>(m_direction));
         }
     }
 }
 
-// MODIFIED update to use textures from Game for animation
-void Tank::update(sf::Time dt, Game& game) {
+// MODIFIED update to use textures from World for animation
+void Tank::update(sf::Time dt, World& world) {
     // 1. 更新动画 (这部分可以放在前面或后面，不影响速度计算的核心逻辑)
-    const auto& frames = game.getTankTextures(m_tankType, m_direction);
+    // 按累计的模拟时间换帧，播放速度不随 simulation.tick_rate_hz 变化
+    const auto& frames = world.getTankTextures(m_tankTypeHandle, m_direction);
     if (!frames.empty()) {
-        int numFrames = frames.size();
-        if (numFrames > 0) {
-            m_currentFrame = (m_currentFrame + 1) % numFrames;
-            m_sprite.setTexture(frames[m_currentFrame]);
+        const int numFrames = static_cast<int>(frames.size());
+        const sf::Time frameDuration = sf::seconds(ANIMATION_FRAME_SECONDS);
+        m_animationTimer += dt;
+        if (m_animationTimer >= frameDuration) {
+            const int framesElapsed = static_cast<int>(m_animationTimer / frameDuration);
+            m_animationTimer -= frameDuration * static_cast<float>(framesElapsed);
+            m_currentFrame = (m_currentFrame + framesElapsed) % numFrames;
+            frames[m_currentFrame].applyTo(m_sprite);
         }
     }
 
@@ -113,7 +125,7 @@ void Tank::update(sf::Time dt, Game& game) {
             m_currentAttackPower = m_baseAttackPower;
             m_isAttackBuffActive = false;
             m_attackBuffDuration = sf::Time::Zero;
-            std::cout << "Attack buff for tank type '" << m_tankType << "' ended" << std::endl;
+            LOG_DEBUG("Attack buff for tank type '" << m_tankType << "' ended");
         }
     }
 
@@ -123,13 +135,13 @@ void Tank::update(sf::Time dt, Game& game) {
             m_shootCooldown = m_baseShootCooldown;
             m_isAttackSpeedBuffActive = false;
             m_attackSpeedBuffDuration = sf::Time::Zero;
-            std::cout << "Attack Speed buff for tank type '" << m_tankType << "' expired. Shoot cooldown reset to: " << m_shootCooldown.asSeconds() << "s" << std::endl;
+            LOG_DEBUG("Attack Speed buff for tank type '" << m_tankType << "' expired. Shoot cooldown reset to: " << m_shootCooldown.asSeconds() << "s");
         }
     }
 
     // --- 核心速度计算 ---
     // a. 从基础速度开始，应用地形效果
-    const Map& map = game.getMap(); // 使用 const 引用获取地图
+    const Map& map = world.getMap(); // 使用 const 引用获取地图
     int currentTileX = static_cast<int>(m_position.x / map.getTileWidth());
     int currentTileY = static_cast<int>(m_position.y / map.getTileHeight());
     int tileTypeOn = -1; // 默认无效地块
@@ -158,7 +170,7 @@ void Tank::update(sf::Time dt, Game& game) {
             m_movementSpeedBuffDuration = sf::Time::Zero;
             m_movementSpeedBuffIncrease = 0.0f; // Buff 结束，清除增加量
             m_speed = speedAfterTerrain; // 最终速度是地形调整后的速度
-            std::cout << "Movement Speed buff for tank type '" << m_tankType << "' expired. Speed is now: " << m_speed << std::endl;
+            LOG_DEBUG("Movement Speed buff for tank type '" << m_tankType << "' expired. Speed is now: " << m_speed);
         } else { // Buff 仍然激活
             m_speed = speedAfterTerrain + m_movementSpeedBuffIncrease; // 在地形调整后的速度基础上增加buff量
         }
@@ -169,9 +181,8 @@ void Tank::update(sf::Time dt, Game& game) {
 }
 
 void Tank::move(sf::Vector2f targetPosition, const Map& map) {
-    sf::Sprite prospectiveSprite = m_sprite; // Sprite uses currently set texture
-    prospectiveSprite.setPosition(targetPosition);
-    sf::FloatRect originalTankBoundsAtTarget = prospectiveSprite.getGlobalBounds();
+    // 碰撞盒由帧尺寸决定，无界面模式下没有纹理也能正确检测
+    sf::FloatRect originalTankBoundsAtTarget = getBoundsAt(targetPosition);
     const float shrinkValue = 2.f;
     sf::FloatRect checkingBounds = originalTankBoundsAtTarget;
 
@@ -186,7 +197,7 @@ void Tank::move(sf::Vector2f targetPosition, const Map& map) {
     int tileH = map.getTileHeight();
 
     if (tileW <= 0 || tileH <= 0) {
-        std::cerr << "Error! Tank::move for type '" << m_tankType << "': Tile width or height is zero or negative. W: " << tileW << ", H: " << tileH << std::endl;
+        LOG_ERROR("Error! Tank::move for type '" << m_tankType << "': Tile width or height is zero or negative. W: " << tileW << ", H: " << tileH);
         return;
     }
 
@@ -214,8 +225,8 @@ void Tank::move(sf::Vector2f targetPosition, const Map& map) {
     }
 }
 
-// MODIFIED shoot to get bullet texture from Game cache using string key
-void Tank::shoot(Game& gameInstance) { // ***修改返回类型为 void***
+// MODIFIED shoot to get bullet texture from World (ResourceManager cache) using string key
+void Tank::shoot(World& world) { // ***修改返回类型为 void***
     if (m_shootTimer < m_shootCooldown) {
         // return nullptr; // 旧的返回
         return; // 直接返回，不射击
@@ -224,24 +235,22 @@ void Tank::shoot(Game& gameInstance) { // ***修改返回类型为 void***
 
     Direction currentTankDir = get_Direction();
     sf::Vector2f flyVec;
-    std::string bulletTextureKey;
 
-    // ... (switch case 设置 flyVec 和 bulletTextureKey 的逻辑不变) ...
     switch (currentTankDir) {
-        case Direction::UP:    flyVec = sf::Vector2f(0.f, -1.f); bulletTextureKey = "bullet_up";    break;
-        case Direction::DOWN:  flyVec = sf::Vector2f(0.f, 1.f);  bulletTextureKey = "bullet_down";  break;
-        case Direction::LEFT:  flyVec = sf::Vector2f(-1.f, 0.f); bulletTextureKey = "bullet_left";  break;
-        case Direction::RIGHT: flyVec = sf::Vector2f(1.f, 0.f);  bulletTextureKey = "bullet_right"; break;
+        case Direction::UP:    flyVec = sf::Vector2f(0.f, -1.f); break;
+        case Direction::DOWN:  flyVec = sf::Vector2f(0.f, 1.f);  break;
+        case Direction::LEFT:  flyVec = sf::Vector2f(-1.f, 0.f); break;
+        case Direction::RIGHT: flyVec = sf::Vector2f(1.f, 0.f);  break;
         default:
-            std::cerr << "Tank::shoot() for type '" << m_tankType << "' - Invalid tank direction!" << std::endl;
+            LOG_ERROR("Tank::shoot() for type '" << m_tankType << "' - Invalid tank direction!");
             // return nullptr; // 旧的返回
             return;
     }
 
 
-    const sf::Texture& bulletTexture = gameInstance.getTexture(bulletTextureKey);
-    if (bulletTexture.getSize().x == 0 || bulletTexture.getSize().y == 0) {
-        std::cerr << "Tank::shoot() for type '" << m_tankType << "' - Failed to get bullet texture for key '" << bulletTextureKey << "' or texture is invalid." << std::endl;
+    const TextureRegion& bulletTexture = world.getBulletTexture(currentTankDir); // 编号在初始化子弹池时已解析
+    if (!world.isHeadless() && (bulletTexture.getSize().x == 0 || bulletTexture.getSize().y == 0)) {
+        LOG_ERROR("Tank::shoot() for type '" << m_tankType << "' - Failed to get bullet texture for direction " << static_cast<int>(currentTankDir) << " or texture is invalid.");
         // return nullptr; // 旧的返回
         return;
     }
@@ -258,17 +267,13 @@ void Tank::shoot(Game& gameInstance) { // ***修改返回类型为 void***
 
     int bulletDamage = getCurrentAttackPower();
     float bulletSpeedValue = 200.f; // 子弹速度应该是一个可配置的或常量
-    int bulletType = (m_tankType == "player") ? 1 : 2; // 简单示例：玩家子弹类型1，AI子弹类型2
-
-    // ***从对象池获取并重置子弹***
-    Bullet* bulletToShoot = gameInstance.getAvailableBullet();
-    if (bulletToShoot) {
-        bulletToShoot->reset(bulletTexture, bulletStartPos, currentTankDir, flyVec,
-                             bulletDamage, bulletSpeedValue, bulletType);
-        // bulletToShoot->setIsAlive(true); // reset 方法内部应该已经做了这个
-        std::cout << "Tank type '" << m_tankType << "' shot a bullet from pool. TextureKey: " << bulletTextureKey << std::endl;
+    int bulletType = (m_kind == TankKind::Player) ? 1 : 2; // 玩家子弹类型1，AI子弹类型2 (按种类标记，不再比较字符串)
+
+    // ***从对象池发射子弹 (子弹不持有纹理，渲染时按方向取对应的子弹纹理)***
+    if (world.spawnBullet(bulletStartPos, currentTankDir, flyVec, bulletDamage, bulletSpeedValue, bulletType)) {
+        LOG_DEBUG("Tank type '" << m_tankType << "' shot a bullet from pool.");
     } else {
-        std::cout << "Tank type '" << m_tankType << "' failed to get a bullet from pool (pool might be full or error)." << std::endl;
+        LOG_DEBUG("Tank type '" << m_tankType << "' failed to get a bullet from pool (pool might be full or error).");
     }
     // 不再返回 unique_ptr
     // return std::make_unique<Bullet>(bulletTexture, bulletStartPos, currentTankDir, flyVec,
@@ -282,21 +287,22 @@ void Tank::takeDamage(int damageAmount) {
 
     if (m_armor > 0) {
         m_armor--;
-        std::cout << "Tank type '" << m_tankType << "' armor absorbed the damage. Armor left: " << m_armor << std::endl;
+        LOG_DEBUG("Tank type '" << m_tankType << "' armor absorbed the damage. Armor left: " << m_armor);
         return;
     }
 
     m_health -= damageAmount;
-    std::cout << "Tank type '" << m_tankType << "' took damage: " << damageAmount << ". Health: " << m_health << std::endl;
+    LOG_DEBUG("Tank type '" << m_tankType << "' took damage: " << damageAmount << ". Health: " << m_health);
     if (m_health <= 0) {
         m_health = 0;
         m_Destroyed = true;
-        std::cout << "Tank type '" << m_tankType << "' at (" << m_position.x << ", " << m_position.y << ") is destroyed!" << std::endl;
+        LOG_DEBUG("Tank type '" << m_tankType << "' at (" << m_position.x << ", " << m_position.y << ") is destroyed!");
     }
 }
 
-void Tank::revive(sf::Vector2f position, Direction direction, Game& game) { // Added Game& for texture consistency on revive
+void Tank::revive(sf::Vector2f position, Direction direction, World& world) { // World& keeps texture consistent on revive
     m_position = position;
+    m_prevPosition = position; // 复活是瞬移，不做插值
     m_direction = direction; // Set direction before fetching texture
     m_Destroyed = false;
     m_health = m_MaxHealth;
@@ -313,16 +319,16 @@ void Tank::revive(sf::Vector2f position, Direction direction, Game& game) { // A
 
 
     m_sprite.setPosition(m_position);
-    // Set texture for new direction using Game object
-    const auto& frames = game.getTankTextures(m_tankType, m_direction);
+    // Set texture for new direction using World object
+    const auto& frames = world.getTankTextures(m_tankTypeHandle, m_direction);
     if (!frames.empty()) {
         m_currentFrame = 0; // Reset animation frame
-        m_sprite.setTexture(frames[m_currentFrame]);
-    } else {
-        std::cerr << "Tank::revive Error: Texture not found for tank type '"
-                  << m_tankType << "' and direction " << static_cast<int>(m_direction) << std::endl;
+        frames[m_currentFrame].applyTo(m_sprite);
+    } else if (!world.isHeadless()) {
+        LOG_ERROR("Tank::revive Error: Texture not found for tank type '"
+                  << m_tankType << "' and direction " << static_cast<int>(m_direction));
     }
-    std::cout << "Tank type '" << m_tankType << "' at (" << m_position.x << ", " << m_position.y << ") is revived!" << std::endl;
+    LOG_DEBUG("Tank type '" << m_tankType << "' at (" << m_position.x << ", " << m_position.y << ") is revived!");
 }
 
 
@@ -335,8 +341,8 @@ void Tank::activateAttackBuff(float multiplier, sf::Time duration) {
     m_currentAttackPower = static_cast<int>(m_baseAttackPower * multiplier);
     m_attackBuffDuration = duration;
     m_isAttackBuffActive = true;
-    std::cout << "Tank type '" << m_tankType << "' Attack buff activated! Current attack: " << m_currentAttackPower
-              << " for " << duration.asSeconds() << "s" << std::endl;
+    LOG_DEBUG("Tank type '" << m_tankType << "' Attack buff activated! Current attack: " << m_currentAttackPower
+              << " for " << duration.asSeconds() << "s");
 }
 
 int Tank::getCurrentAttackPower() const {
@@ -347,8 +353,8 @@ void Tank::activateAttackSpeedBuff(float cooldownMultiplier, sf::Time duration)
     m_shootCooldown = m_baseShootCooldown * cooldownMultiplier;
     m_attackSpeedBuffDuration = duration;
     m_isAttackSpeedBuffActive = true;
-    std::cout << "Tank type '" << m_tankType << "' Attack Speed buff activated! Shoot cooldown: " << m_shootCooldown.asSeconds()
-              << "s for " << duration.asSeconds() << "s" << std::endl;
+    LOG_DEBUG("Tank type '" << m_tankType << "' Attack Speed buff activated! Shoot cooldown: " << m_shootCooldown.asSeconds()
+              << "s for " << duration.asSeconds() << "s");
 }
 
 void Tank::setSpeed(float newSpeed) {
@@ -366,7 +372,7 @@ void Tank::activateMovementSpeedBuff(float increaseAmount, sf::Time duration) {
     m_movementSpeedBuffDuration = duration;
     m_isMovementSpeedBuffActive = true;
     // m_speed 的实际更新会在 Tank::update 中基于地形和这个 buffIncrease 来计算
-    std::cout << "Tank type '" << m_tankType << "' Movement Speed buff activated! Base speed will effectively increase by " << increaseAmount
-              << " for " << duration.asSeconds() << "s (terrain effects will also apply)" << std::endl;
+    LOG_DEBUG("Tank type '" << m_tankType << "' Movement Speed buff activated! Base speed will effectively increase by " << increaseAmount
+              << " for " << duration.asSeconds() << "s (terrain effects will also apply)");
 }
 
@@ -7,19 +7,27 @@
 #include "heads.h"      // 包含项目通用的头文件 (如 SFML/Graphics.hpp, iostream 等)
 #include "Map.h"        // 包含地图类定义，用于碰撞检测和移动限制
 #include "common.h"     // 包含通用定义，例如 Direction 枚举
+#include "AssetRegistry.h" // TankTypeHandle (动画帧按编号索引)
 #include <vector>       // 使用 std::vector (虽然纹理现在由Game管理，但保留以防其他用途)
 #include <string>       // 使用 std::string
+#include <cstdint>      // std::uint8_t (TankKind)
 
 // =========================================================================
 // 宏定义与常量
 // =========================================================================
 #define FOREST_SLOWDOWN_FACTOR 0.7f // 森林地形的减速因子
 
+// 坦克种类标记：热路径上用它区分玩家/AI，代替 dynamic_cast
+enum class TankKind : std::uint8_t {
+    Player,
+    AI
+};
+
 // =========================================================================
 // 前向声明 (Forward Declarations)
 // =========================================================================
-class Bullet;           // 子弹类，Tank 可以发射子弹
-class Game;             // 游戏主类，Tank 需要与 Game 对象交互 (例如获取纹理、发射子弹时)
+class World;            // 模拟核心，Tank 需要与 World 对象交互 (例如获取纹理、发射子弹时)
+class SpriteBatch;      // 批量绘制 (坦克不再各自调用 window.draw)
 
 class Tank {
 protected:
@@ -29,6 +37,7 @@ protected:
     // std::vector<sf::Texture> m_textures; // 纹理现在由 Game 类管理和提供
     sf::Sprite m_sprite;                 // 坦克的精灵，用于在窗口上绘制
     int m_currentFrame;                  // 当前动画帧索引 (如果每个方向有多帧动画)
+    sf::Time m_animationTimer;           // 当前动画帧已显示的模拟时间 (与tick频率无关)
     int m_frameWidth;                    // 坦克纹理单帧的宽度 (像素)
     int m_frameHeight;                   // 坦克纹理单帧的高度 (像素)
 
@@ -36,6 +45,7 @@ protected:
     // 位置与移动相关成员
     // =========================================================================
     sf::Vector2f m_position;             // 坦克在地图上的精确位置 (通常是中心点)
+    sf::Vector2f m_prevPosition;         // 上一个模拟tick开始时的位置 (用于渲染插值)
     Direction m_direction;               // 坦克当前的朝向 (UP, DOWN, LEFT, RIGHT)
     float m_baseSpeed;                   // 坦克的基础移动速度 (不受临时buff或地形影响)
     float m_speed;                       // 坦克当前的实际移动速度 (像素/秒)
@@ -81,11 +91,14 @@ protected:
     // =========================================================================
     std::string m_tankType;              // 坦克类型 (例如 "player", "ai_default", "ai_fast")
     int m_scoreValue;                    // 击毁此坦克可获得的分数 (主要用于AI坦克)
+    TankKind m_kind;                     // 坦克种类 (由派生类在构造时指定，之后不变)
+    TankTypeHandle m_tankTypeHandle;     // m_tankType 在构造时解析出的编号 (无界面模式下无效)
 
     // =========================================================================
     // 静态常量
     // =========================================================================
     static const int MAX_ARMOR = 1;      // 坦克的最大护甲值上限
+    static constexpr float ANIMATION_FRAME_SECONDS = 1.f / 60.f; // 每个动画帧的时长 (原先按 60fps 每渲染帧换一帧)
 
 public:
     // =========================================================================
@@ -94,30 +107,31 @@ public:
     // 参数:
     //   startPosition - 初始位置 (中心点)
     //   startDirection - 初始方向
-    //   tankType - 坦克类型字符串 (用于从Game获取纹理等)
-    //   game - 对Game对象的引用
+    //   tankType - 坦克类型字符串 (用于从World获取纹理等)
+    //   world - 对World对象的引用
     //   speed - 初始基础速度
     //   frameWidth - 纹理帧宽度
     //   frameHeight - 纹理帧高度
     //   iniHealth - 初始生命值
     //   armor - 初始护甲值
     //   scoreValue - 击毁该坦克获得的分数
-    Tank(sf::Vector2f startPosition, Direction startDirection, const std::string& tankType, Game& game,
-         float speed, int frameWidth, int frameHeight, int iniHealth, int armor, int scoreValue);
+    //   kind - 坦克种类 (玩家/AI)
+    Tank(sf::Vector2f startPosition, Direction startDirection, const std::string& tankType, World& world,
+         float speed, int frameWidth, int frameHeight, int iniHealth, int armor, int scoreValue, TankKind kind);
     virtual ~Tank() = default;           // 虚析构函数，确保派生类的析构函数被正确调用
 
     // =========================================================================
     // 核心游戏逻辑方法
     // =========================================================================
-    void draw(sf::RenderWindow& window); // 将坦克绘制到指定的渲染窗口
-    virtual void update(sf::Time dt, Game& game);    // 更新坦克状态 (动画、计时器、buff等)，dt是帧间隔时间
+    void draw(SpriteBatch& batch, float alpha = 1.f); // 把坦克的四边形加入批次 (由调用方统一提交)，alpha 为上一tick到当前tick之间的插值系数
+    virtual void update(sf::Time dt, World& world);    // 更新坦克状态 (动画、计时器、buff等)，dt是帧间隔时间
     void move(sf::Vector2f targetPosition, const Map& map); // 尝试将坦克移动到目标位置，会进行地图碰撞检测
-    void shoot(Game& gameInstance);      // 创建并发射一颗子弹 (通过Game对象池)
+    void shoot(World& world);            // 创建并发射一颗子弹 (通过World对象池)
 
     // =========================================================================
     // Setter 方法
     // =========================================================================
-    void setDirection(Direction dir, Game& game);   // 设置坦克的新方向，并请求Game更新纹理
+    void setDirection(Direction dir, World& world); // 设置坦克的新方向，并请求World更新纹理
     void setSpeed(float newSpeed);                  // 设置坦克的基础速度
     void setArmor(int newArmor);                    // 设置坦克的护甲值 (会受MAX_ARMOR限制)
 
@@ -129,7 +143,13 @@ public:
     Direction get_Direction() const { return m_direction; } // 注意：原为 get_Direction()，保持一致或改为 getDirection()
     int getFrameWidth() const { return m_frameWidth; }     // 原为 get_TileWight()
     int getFrameHeight() const { return m_frameHeight; }   // 原为 get_TileHeight()
-    sf::FloatRect getBounds() const { return m_sprite.getGlobalBounds(); } // 获取全局边界框
+    sf::Vector2f getInterpolatedPosition(float alpha) const { return m_prevPosition + (m_position - m_prevPosition) * alpha; }
+    void storePreviousPosition() { m_prevPosition = m_position; } // 每个模拟tick开始时调用
+    sf::FloatRect getBounds() const { return getBoundsAt(m_position); } // 获取全局边界框 (由帧尺寸决定，不依赖纹理)
+    sf::FloatRect getBoundsAt(sf::Vector2f center) const {
+        return sf::FloatRect(center.x - m_frameWidth / 2.f, center.y - m_frameHeight / 2.f,
+                             static_cast<float>(m_frameWidth), static_cast<float>(m_frameHeight));
+    }
 
     // 状态与属性
     float getSpeed() const { return m_speed; }
@@ -138,7 +158,10 @@ public:
     int getArmor() const { return m_armor; }
     bool isDestroyed() const { return m_Destroyed; }
     const std::string& getTankType() const { return m_tankType; }
+    TankTypeHandle getTankTypeHandle() const { return m_tankTypeHandle; }
     int getScoreValue() const { return m_scoreValue; }
+    TankKind getKind() const { return m_kind; }
+    bool isAI() const { return m_kind == TankKind::AI; }
     int getCurrentAttackPower() const; // 获取当前攻击力 (考虑buff)
     sf::Time getShootCooldown() const { return m_shootCooldown; } // 获取当前射击冷却
 
@@ -157,7 +180,8 @@ public:
     // 生命与伤害处理
     // =========================================================================
     void takeDamage(int damageAmount); // 坦克受到伤害
-    void revive(sf::Vector2f position, Direction direction, Game& game); // 复活/重置坦克状态
+    void markDestroyed() { m_Destroyed = true; } // 直接标记为已摧毁 (不计分)，由 World 在本tick末统一移除
+    void revive(sf::Vector2f position, Direction direction, World& world); // 复活/重置坦克状态
 };
 
 #endif // TANK_H